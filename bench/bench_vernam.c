@@ -0,0 +1,242 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <cryptography.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file bench_vernam.c
+ * @brief Vernam and gamma output bandwidth, cached vs non-temporal stores
+ * 
+ * A co-running thread walks a random pointer chain over a working set
+ * that fits in cache. Its time per access shows how much of its data
+ * the XOR evicts: every miss costs a trip to memory.
+ * 
+ * Gamma is bound by bit-serial keystream generation, so it runs one
+ * round over a sixteenth of the buffer (still above the default
+ * threshold of 8 MiB).
+ * 
+ * Usage: bench_vernam [buffer MiB] [co-runner working set KiB]
+ */
+
+#define DEFAULT_BUFFER_MIB 256
+#define DEFAULT_WORKING_SET_KIB 2048
+#define ROUNDS 5
+#define GAMMA_ROUNDS 1
+#define GAMMA_BUFFER_DIVISOR 16
+
+/**
+ * @brief Cipher transform under test: out = data ^ keystream
+ */
+typedef void (*bench_transform)(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t size);
+
+struct co_runner {
+    size_t* chain;
+    _Atomic int running;
+    _Atomic int measuring;
+    _Atomic int started;
+    _Atomic int done;
+    size_t position;
+    uint64_t accesses;
+    double seconds;
+};
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Build single random cycle over n slots (Sattolo's algorithm)
+ */
+static size_t* make_chain(size_t n)
+{
+    size_t* chain = (size_t*)malloc(n * sizeof(size_t));
+    if (!chain)
+        return NULL;
+    
+    for (size_t i = 0; i < n; i++)
+        chain[i] = i;
+    
+    uint64_t x = 88172645463325252ULL;
+    for (size_t i = n - 1; i > 0; i--)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        size_t j = (size_t)(x % i);
+        size_t t = chain[i];
+        chain[i] = chain[j];
+        chain[j] = t;
+    }
+    
+    return chain;
+}
+
+static void* co_runner_run(void* arg)
+{
+    struct co_runner* co = (struct co_runner*)arg;
+    size_t pos = 0;
+    
+    while (atomic_load(&co->running))
+    {
+        if (!atomic_load(&co->measuring))
+        {
+            pos = co->chain[pos];
+            continue;
+        }
+        
+        uint64_t count = 0;
+        double start = now_seconds();
+        atomic_store(&co->started, 1);
+        
+        while (atomic_load(&co->measuring))
+        {
+            for (int i = 0; i < 256; i++)
+                pos = co->chain[pos];
+            count += 256;
+        }
+        
+        co->seconds = now_seconds() - start;
+        co->accesses = count;
+        co->position = pos;
+        atomic_store(&co->done, 1);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Start co-runner measurement, wait until it is running
+ */
+static void co_runner_begin(struct co_runner* co)
+{
+    atomic_store(&co->measuring, 1);
+    while (!atomic_load(&co->started))
+        ;
+    atomic_store(&co->started, 0);
+}
+
+/**
+ * @brief Stop co-runner measurement, wait for its result
+ * 
+ * @return Nanoseconds per access
+ */
+static double co_runner_end(struct co_runner* co)
+{
+    atomic_store(&co->measuring, 0);
+    while (!atomic_load(&co->done))
+        ;
+    atomic_store(&co->done, 0);
+    
+    return co->seconds * 1e9 / (double)co->accesses;
+}
+
+static void transform_vernam(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t size)
+{
+    vernam_xor(data, size, key, size, out);
+}
+
+static void transform_gamma(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t size)
+{
+    struct gamma_stream_ctx ctx;
+    
+    (void)key;
+    gamma_stream_init(&ctx, 12345, size);
+    gamma_stream_update(&ctx, data, size, out);
+    gamma_stream_final(&ctx);
+}
+
+/**
+ * @brief Run transform rounds with co-runner measuring, print results
+ * 
+ * Bandwidth counts every byte read or written (data, key if any, output).
+ */
+static void run_case(const char* name, struct co_runner* co, bench_transform transform, int streams,
+    unsigned char* data, unsigned char* key, unsigned char* out, size_t size, size_t threshold, int rounds)
+{
+    vernam_set_stream_threshold(threshold);
+    transform(data, key, out, size);
+    
+    co_runner_begin(co);
+    double start = now_seconds();
+    
+    for (int r = 0; r < rounds; r++)
+        transform(data, key, out, size);
+    
+    double seconds = now_seconds() - start;
+    double latency = co_runner_end(co);
+    double gib = (double)size * streams * rounds / (1024.0 * 1024.0 * 1024.0);
+    printf("%-16s  %8.2f GiB/s   co-runner %7.2f ns/access\n",
+        name, gib / seconds, latency);
+}
+
+int main(int argc, char** argv)
+{
+    size_t size = (size_t)(argc > 1 ? atol(argv[1]) : DEFAULT_BUFFER_MIB) * 1024 * 1024;
+    size_t working_set = (size_t)(argc > 2 ? atol(argv[2]) : DEFAULT_WORKING_SET_KIB) * 1024;
+    
+    if (size == 0 || working_set < sizeof(size_t) * 2)
+    {
+        fprintf(stderr, "Usage: %s [buffer MiB] [co-runner working set KiB]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    unsigned char* data = (unsigned char*)malloc(size);
+    unsigned char* key = (unsigned char*)malloc(size);
+    unsigned char* out = (unsigned char*)malloc(size);
+    struct co_runner co;
+    
+    memset(&co, 0, sizeof(co));
+    co.chain = make_chain(working_set / sizeof(size_t));
+    
+    if (!data || !key || !out || !co.chain)
+    {
+        fprintf(stderr, "Memory error!\n");
+        return EXIT_FAILURE;
+    }
+    
+    memset(data, 0x5A, size);
+    memset(key, 0xC3, size);
+    memset(out, 0, size);
+    
+    size_t gamma_size = size / GAMMA_BUFFER_DIVISOR ? size / GAMMA_BUFFER_DIVISOR : size;
+    
+    printf("Vernam %zu MiB x %d rounds, gamma %zu KiB x %d rounds, co-runner working set %zu KiB\n",
+        size / (1024 * 1024), ROUNDS, gamma_size / 1024, GAMMA_ROUNDS, working_set / 1024);
+    
+    
+    pthread_t thread;
+    atomic_store(&co.running, 1);
+    if (pthread_create(&thread, NULL, co_runner_run, &co) != 0)
+    {
+        fprintf(stderr, "Failed to start co-runner!\n");
+        return EXIT_FAILURE;
+    }
+    
+    struct timespec idle = {0, 200 * 1000 * 1000};
+    co_runner_begin(&co);
+    nanosleep(&idle, NULL);
+    printf("%-16s  %8s         co-runner %7.2f ns/access\n", "idle", "-", co_runner_end(&co));
+    
+    run_case("vernam cached", &co, transform_vernam, 3, data, key, out, size, SIZE_MAX, ROUNDS);
+    run_case("vernam stream", &co, transform_vernam, 3, data, key, out, size, 0, ROUNDS);
+    run_case("gamma cached", &co, transform_gamma, 2, data, NULL, out, gamma_size, SIZE_MAX, GAMMA_ROUNDS);
+    run_case("gamma stream", &co, transform_gamma, 2, data, NULL, out, gamma_size, 0, GAMMA_ROUNDS);
+    
+    atomic_store(&co.running, 0);
+    pthread_join(thread, NULL);
+    
+    free(co.chain);
+    free(out);
+    free(key);
+    free(data);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -39,6 +39,66 @@ void print_menu()
     printf("Select cipher>");
 }
 
+/**
+ * @brief Reads one line without trailing newline
+ */
+int read_line(const char* prompt, char* buffer)
+{
+    printf("%s", prompt);
+    if (!fgets(buffer, MAX_INPUT, stdin))
+        return 0;
+
+    size_t len = strlen(buffer);
+    if (len > 0 && buffer[len-1] == '\n')
+        buffer[len-1] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Recovers key of Caesar or Trithemius ciphertext
+ */
+void crack_menu(int trithemius)
+{
+    char input[MAX_INPUT];
+    char* result = NULL;
+    struct crack_candidate ranked[26];
+    enum crypto_status status;
+
+    if (!read_line("Enter ciphertext>", input))
+    {
+        printf("Failed to read input!\n");
+        return;
+    }
+
+    if (trithemius)
+        status = crack_trithemius(input, NULL, ranked);
+    else
+        status = crack_caesar(input, NULL, ranked);
+
+    if (status != CRYPTO_SUCCESS)
+    {
+        printf("\nError: %s\n", crypto_status_output(status));
+        return;
+    }
+
+    printf("\nMost likely keys:\n");
+    for (int i = 0; i < 3; i++)
+        printf("  key %2d  chi-squared %.2f\n", ranked[i].key, ranked[i].score);
+
+    if (trithemius)
+        status = decrypt_trithemius(input, ranked[0].key, &result);
+    else
+        status = decrypt_caesar(input, ranked[0].key, &result);
+
+    if (status == CRYPTO_SUCCESS)
+    {
+        printf("\nResult: %s\n", result);
+        free(result);
+    }
+    else 
+        printf("\nError: %s\n", crypto_status_output(status));
+}
+
 void caesar_menu()
 {
     int action, key;
@@ -49,6 +109,7 @@ void caesar_menu()
     printf("\n--- Caesar Cipher ---\n");
     printf("1. Encrypt\n");
     printf("2. Decrypt\n");
+    printf("3. Crack (unknown key)\n");
     printf("Select action>");
 
     if (scanf("%d", &action) != 1)
@@ -59,6 +120,12 @@ void caesar_menu()
     }
     clear_input_buffer();
 
+    if (action == 3)
+    {
+        crack_menu(0);
+        return;
+    }
+
     if (action != 1 && action != 2)
     {
         printf("Invalid action!\n");
@@ -109,6 +176,7 @@ void trithemius_menu()
     printf("\n--- Trithemius Cipher ---\n");
     printf("1. Encrypt\n");
     printf("2. Decrypt\n");
+    printf("3. Crack (unknown key)\n");
     printf("Select action>");
 
     if (scanf("%d", &action) != 1)
@@ -119,6 +187,12 @@ void trithemius_menu()
     }
     clear_input_buffer();
 
+    if (action == 3)
+    {
+        crack_menu(1);
+        return;
+    }
+
     if (action != 1 && action != 2)
     {
         printf("Invalid action!\n");
@@ -163,7 +237,9 @@ void polybius_menu()
 {
     int action;
     char input[MAX_INPUT];
+    char keyword[MAX_INPUT];
     char* result = NULL;
+    struct polybius_ctx ctx;
     enum crypto_status status;
 
     printf("\n--- Polybius Cipher ---\n");
@@ -185,6 +261,19 @@ void polybius_menu()
         return;
     }
 
+    if (!read_line("Enter keyword (empty = standard square)>", keyword))
+    {
+        printf("Failed to read input!\n");
+        return;
+    }
+
+    status = polybius_ctx_init(&ctx, keyword);
+    if (status != CRYPTO_SUCCESS)
+    {
+        printf("\nError: %s\n", crypto_status_output(status));
+        return;
+    }
+
     printf("Enter text>");
     if (!fgets(input, MAX_INPUT, stdin))
     {
@@ -197,9 +286,9 @@ void polybius_menu()
         input[len-1] = '\0';
 
     if (action == 1)
-        status = encrypt_polybius(input, &result);
+        status = encrypt_polybius_ctx(&ctx, input, &result);
     else
-        status = decrypt_polybius(input, &result);
+        status = decrypt_polybius_ctx(&ctx, input, &result);
 
     if (status == CRYPTO_SUCCESS)
     {
@@ -273,6 +362,67 @@ void vigenere_menu()
         printf("\nError: %s\n", crypto_status_output(status));
 }
 
+/**
+ * @brief Vernam XOR of whole files (memory-mapped)
+ */
+void vernam_file_menu()
+{
+    char data_path[MAX_INPUT];
+    char key_path[MAX_INPUT];
+    char output_path[MAX_INPUT];
+    enum crypto_status status;
+
+    if (!read_line("Enter input file>", data_path) ||
+        !read_line("Enter key file>", key_path) ||
+        !read_line("Enter output file (empty = in place)>", output_path))
+    {
+        printf("Failed to read input!\n");
+        return;
+    }
+
+    if (output_path[0] == '\0')
+        status = vernam_xor_file_in_place(data_path, key_path);
+    else
+        status = vernam_xor_file(data_path, key_path, output_path);
+
+    if (status == CRYPTO_SUCCESS)
+        printf("\nDone.\n");
+    else 
+        printf("\nError: %s\n", crypto_status_output(status));
+}
+
+/**
+ * @brief Generates random key (pad) file
+ */
+void vernam_keygen_menu()
+{
+    char path[MAX_INPUT];
+    unsigned long long size;
+    enum crypto_status status;
+
+    if (!read_line("Enter key file>", path))
+    {
+        printf("Failed to read input!\n");
+        return;
+    }
+
+    printf("Enter size in bytes>");
+    if (scanf("%llu", &size) != 1)
+    {
+        printf("Invalid input!\n");
+        clear_input_buffer();
+        return;
+    }
+    clear_input_buffer();
+
+    status = vernam_generate_key_file(path, (uint64_t)size, 0);
+
+    if (status == CRYPTO_SUCCESS)
+        printf("\nDone.\n");
+    else 
+        printf("\nError: %s\n", crypto_status_output(status));
+}
+
 void vernam_menu()
 {
     int action;
@@ -285,6 +435,8 @@ void vernam_menu()
     printf("Note: XOR cipher, works with bytes\n");
     printf("1. Encrypt (text → hex)\n");
     printf("2. Decrypt (hex → text)\n");
+    printf("3. Encrypt/decrypt file with key file\n");
+    printf("4. Generate random key file\n");
     printf("Select action> ");
 
     if (scanf("%d", &action) != 1)
@@ -295,6 +447,18 @@ void vernam_menu()
     }
     clear_input_buffer();
 
+    if (action == 3)
+    {
+        vernam_file_menu();
+        return;
+    }
+
+    if (action == 4)
+    {
+        vernam_keygen_menu();
+        return;
+    }
+
     if (action != 1 && action != 2)
     {
         printf("Invalid action!\n");
@@ -2,6 +2,8 @@
 #define CRYPTO_CAESAR_H
 
 #include "core.h"
+#include <stddef.h>
+#include <sys/uio.h>
 
 /**
  * @file caesar.h
@@ -38,4 +40,99 @@ enum crypto_status encrypt_caesar(const char* plaintext, int key, char** ciphert
  */
 enum crypto_status decrypt_caesar(const char* ciphertext, int key, char** plaintext);
 
+/**
+ * @brief Encrypts scatter/gather buffers using Caesar cipher.
+ *
+ * Input segments are processed as one text, written into output
+ * segments of any layout with the same total length (no terminators).
+ * Output may be the same vector as input (in place).
+ *
+ * @param input Input segments.
+ * @param input_count Number of input segments.
+ * @param output Output segments.
+ * @param output_count Number of output segments.
+ * @param key Shift value.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if totals differ.
+ */
+enum crypto_status encrypt_caesar_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+);
+
+/**
+ * @brief Decrypts scatter/gather buffers using Caesar cipher.
+ *
+ * @param input Input segments.
+ * @param input_count Number of input segments.
+ * @param output Output segments.
+ * @param output_count Number of output segments.
+ * @param key Shift value used during encryption.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if totals differ.
+ */
+enum crypto_status decrypt_caesar_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+);
+
+/**
+ * @brief Caesar shift prepared for one key.
+ *
+ * Key is normalized once to 0-25; the table maps every byte value,
+ * non-letters (including non-ASCII bytes) to themselves.
+ */
+struct caesar_engine {
+    unsigned char shift;
+    unsigned char table[256];
+};
+
+/**
+ * @brief Streaming Caesar state.
+ *
+ * Caesar shift does not depend on position, so a stream may be
+ * resumed anywhere with a freshly initialized context.
+ */
+struct caesar_stream_ctx {
+    struct caesar_engine engine;
+};
+
+/**
+ * @brief Starts streaming Caesar transformation.
+ *
+ * @param ctx Stream state to initialize. Must not be NULL.
+ * @param key Shift value.
+ * @param decrypt 0 to encrypt, nonzero to decrypt.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status caesar_stream_init(struct caesar_stream_ctx* ctx, int key, int decrypt);
+
+/**
+ * @brief Transforms next chunk of the stream.
+ *
+ * @param ctx Stream state.
+ * @param input Chunk characters (no terminator needed).
+ * @param input_len Chunk length (any size).
+ * @param output Output buffer of input_len characters (may equal input).
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status caesar_stream_update(
+    struct caesar_stream_ctx* ctx,
+    const char* input,
+    size_t input_len,
+    char* output
+);
+
+/**
+ * @brief Finishes streaming Caesar transformation, clearing the state.
+ *
+ * @param ctx Stream state.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status caesar_stream_final(struct caesar_stream_ctx* ctx);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef CRYPTO_CRACK_H
+#define CRYPTO_CRACK_H
+
+#include "core.h"
+#include <stddef.h>
+
+/**
+ * @file crack.h
+ * @brief Key recovery for Caesar and Trithemius ciphers.
+ * 
+ * Letters of the ciphertext are counted once; every one of the 26 keys
+ * is then scored by the chi-squared distance between the letter counts
+ * it would decrypt to and a language model. No decryption is performed.
+ */
+
+/**
+ * @brief Candidate key with its chi-squared score (lower is better).
+ */
+struct crack_candidate {
+    int key;
+    double score;
+};
+
+/**
+ * @brief Ranks all Caesar keys for ciphertext.
+ * 
+ * @param ciphertext Input string. Must not be NULL.
+ * @param model 26 letter frequencies A-Z (any positive scale), or NULL for English.
+ * @param ranked Output: keys 0-25 sorted from most to least likely.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if text has
+ *         no letters or model has a non-positive frequency.
+ */
+enum crypto_status crack_caesar(const char* ciphertext, const double* model, struct crack_candidate ranked[26]);
+
+/**
+ * @brief Ranks all Trithemius keys for ciphertext.
+ * 
+ * Letter i is counted as (C[i] - i) mod 26, which turns the progressive
+ * shift into a fixed one, then keys are scored as for Caesar.
+ * 
+ * @param ciphertext Input string. Must not be NULL.
+ * @param model 26 letter frequencies A-Z (any positive scale), or NULL for English.
+ * @param ranked Output: keys 0-25 sorted from most to least likely.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if text has
+ *         no letters or model has a non-positive frequency.
+ */
+enum crypto_status crack_trithemius(const char* ciphertext, const double* model, struct crack_candidate ranked[26]);
+
+/**
+ * @brief Finds most likely Caesar key of many independent texts.
+ * 
+ * Texts are split between threads.
+ * 
+ * @param ciphertexts Input strings. Must not be NULL.
+ * @param count Number of texts.
+ * @param model 26 letter frequencies A-Z, or NULL for English.
+ * @param threads Maximum number of threads (0 = number of online CPUs).
+ * @param keys Output: best key 0-25 per text, -1 for texts without letters.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status crack_caesar_batch(
+    const char* const* ciphertexts,
+    size_t count,
+    const double* model,
+    size_t threads,
+    int* keys
+);
+
+/**
+ * @brief Finds most likely Trithemius key of many independent texts.
+ * 
+ * @param ciphertexts Input strings. Must not be NULL.
+ * @param count Number of texts.
+ * @param model 26 letter frequencies A-Z, or NULL for English.
+ * @param threads Maximum number of threads (0 = number of online CPUs).
+ * @param keys Output: best key 0-25 per text, -1 for texts without letters.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status crack_trithemius_batch(
+    const char* const* ciphertexts,
+    size_t count,
+    const double* model,
+    size_t threads,
+    int* keys
+);
+
+#endif
\ No newline at end of file
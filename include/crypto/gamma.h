@@ -12,6 +12,34 @@
 #include "core.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <sys/uio.h>
+
+/**
+ * @brief Gamma (keystream) generators
+ * 
+ * XORSHIFT32 is the classic generator: one gamma bit per PRNG round.
+ * Other generators produce whole 64-bit gamma words per step,
+ * with key material derived from the 32-bit seed by splitmix64.
+ */
+enum gamma_generator {
+    GAMMA_GEN_XORSHIFT32 = 0,
+    GAMMA_GEN_XOSHIRO256SS = 1,
+    GAMMA_GEN_CHACHA20 = 2,
+    GAMMA_GEN_AES_CTR = 3
+};
+
+/**
+ * @brief Gamma application modes
+ * 
+ * CLASSIC applies gamma to rows of the bit matrix (textbook layout).
+ * DIRECT XORs gamma bytes straight onto data bytes: every xorshift32
+ * state gives 4 gamma bytes, least significant byte first.
+ * Both modes use the same seed.
+ */
+enum gamma_mode {
+    GAMMA_MODE_CLASSIC = 0,
+    GAMMA_MODE_DIRECT = 1
+};
 
 /**
  * @brief Encrypt using gamma cipher with transposition
@@ -52,4 +80,491 @@ enum crypto_status decrypt_gamma(
     unsigned char** plaintext
 );
 
+/**
+ * @brief Encrypt using gamma cipher in selected mode
+ * 
+ * GAMMA_MODE_CLASSIC gives exactly encrypt_gamma output.
+ * GAMMA_MODE_DIRECT skips bit matrix transposition and
+ * uses 32 gamma bits per PRNG round instead of one.
+ * 
+ * @param plaintext Input bytes
+ * @param plaintext_len Data length
+ * @param seed PRNG seed
+ * @param mode Gamma mode
+ * @param ciphertext Output buffer
+ * @return Status code
+ */
+enum crypto_status encrypt_gamma_mode(
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    enum gamma_mode mode,
+    unsigned char** ciphertext
+);
+
+/**
+ * @brief Decrypt using gamma cipher in selected mode
+ * 
+ * @param ciphertext Input bytes
+ * @param ciphertext_len Data length
+ * @param seed PRNG seed (same as encryption)
+ * @param mode Gamma mode (same as encryption)
+ * @param plaintext Output buffer
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_mode(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    enum gamma_mode mode,
+    unsigned char** plaintext
+);
+
+/**
+ * @brief Gamma cipher context
+ * 
+ * Holds PRNG state owned by the caller, so independent contexts
+ * can be used from different threads at the same time.
+ */
+struct gamma_ctx {
+    uint32_t state;
+};
+
+/**
+ * @brief Initialize gamma context
+ * 
+ * @param ctx Context to initialize
+ * @param seed PRNG seed
+ * @return Status code
+ */
+enum crypto_status gamma_ctx_init(struct gamma_ctx* ctx, uint32_t seed);
+
+/**
+ * @brief Advance gamma context by given number of gamma bits
+ * 
+ * Runs in O(log bits) time, so the context can be seeked to any
+ * position of the gamma sequence without generating it.
+ * 
+ * @param ctx Gamma context
+ * @param bits Number of gamma bits (PRNG rounds) to skip
+ * @return Status code
+ */
+enum crypto_status gamma_ctx_skip(struct gamma_ctx* ctx, uint64_t bits);
+
+/**
+ * @brief Encrypt using gamma cipher with caller-owned context
+ * 
+ * Same as encrypt_gamma, but gamma is taken from the context.
+ * The context advances by 8 * plaintext_len PRNG rounds, so
+ * consecutive calls continue the same gamma sequence.
+ * encrypt_gamma(p, len, seed, c) equals this call on a fresh context.
+ * 
+ * @param ctx Gamma context
+ * @param plaintext Input bytes
+ * @param plaintext_len Data length
+ * @param ciphertext Output buffer
+ * @return Status code
+ */
+enum crypto_status encrypt_gamma_ctx(
+    struct gamma_ctx* ctx,
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    unsigned char** ciphertext
+);
+
+/**
+ * @brief Decrypt using gamma cipher with caller-owned context
+ * 
+ * Context must be in the same state as during encryption.
+ * 
+ * @param ctx Gamma context
+ * @param ciphertext Input bytes
+ * @param ciphertext_len Data length
+ * @param plaintext Output buffer
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_ctx(
+    struct gamma_ctx* ctx,
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    unsigned char** plaintext
+);
+
+/**
+ * @brief Streaming gamma state
+ * 
+ * Holds one PRNG state per bit row, each positioned at the next column,
+ * so data can be processed in chunks with constant memory.
+ * Row r gamma starts at bit r * total_len, therefore the total
+ * length must be known when the stream starts.
+ */
+struct gamma_stream_ctx {
+    uint32_t row_state[8];
+    size_t total_len;
+    size_t position;
+};
+
+/**
+ * @brief Start streaming gamma transformation
+ * 
+ * Same stream is used for encryption and decryption.
+ * Concatenated chunk outputs equal encrypt_gamma / decrypt_gamma output.
+ * 
+ * @param ctx Stream state to initialize
+ * @param seed PRNG seed
+ * @param total_len Total data length of all chunks
+ * @return Status code
+ */
+enum crypto_status gamma_stream_init(struct gamma_stream_ctx* ctx, uint32_t seed, size_t total_len);
+
+/**
+ * @brief Start streaming gamma transformation at byte offset
+ * 
+ * Stream continues as if offset bytes were already processed.
+ * Row states are seeked in O(log total_len) time.
+ * 
+ * @param ctx Stream state to initialize
+ * @param seed PRNG seed
+ * @param total_len Total data length
+ * @param offset Byte offset of the first chunk (0 to total_len)
+ * @return Status code
+ */
+enum crypto_status gamma_stream_init_at(
+    struct gamma_stream_ctx* ctx,
+    uint32_t seed,
+    size_t total_len,
+    size_t offset
+);
+
+/**
+ * @brief Transform next chunk of the stream
+ * 
+ * @param ctx Stream state
+ * @param input Chunk bytes
+ * @param input_len Chunk length (any size, sum must not exceed total_len)
+ * @param output Output buffer of input_len bytes (may equal input)
+ * @return Status code
+ */
+enum crypto_status gamma_stream_update(
+    struct gamma_stream_ctx* ctx,
+    const unsigned char* input,
+    size_t input_len,
+    unsigned char* output
+);
+
+/**
+ * @brief Finish streaming gamma transformation
+ * 
+ * Clears the state.
+ * 
+ * @param ctx Stream state
+ * @return CRYPTO_ERROR_INVALID_INPUT if fewer than total_len bytes were processed
+ */
+enum crypto_status gamma_stream_final(struct gamma_stream_ctx* ctx);
+
+/**
+ * @brief Decrypt byte range of gamma ciphertext
+ * 
+ * Only gamma for the requested columns is generated,
+ * so cost depends on range length, not on ciphertext length.
+ * 
+ * @param ciphertext Whole ciphertext
+ * @param ciphertext_len Length of the whole ciphertext
+ * @param seed PRNG seed (same as encryption)
+ * @param offset First byte of the range
+ * @param length Range length
+ * @param plaintext Output buffer (length bytes)
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_range(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    size_t offset,
+    size_t length,
+    unsigned char** plaintext
+);
+
+/**
+ * @brief Encrypt scatter/gather buffers using gamma cipher
+ * 
+ * Input segments are processed as one message of their total length:
+ * keystream position carries over segment boundaries, result equals
+ * encrypt_gamma of the concatenated input. Output segments may have
+ * any layout with the same total length, and may be the input itself.
+ * 
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param seed PRNG seed
+ * @return Status code (CRYPTO_ERROR_INVALID_INPUT if totals differ or are 0)
+ */
+enum crypto_status encrypt_gamma_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    uint32_t seed
+);
+
+/**
+ * @brief Decrypt scatter/gather buffers using gamma cipher
+ * 
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param seed PRNG seed (same as encryption)
+ * @return Status code (CRYPTO_ERROR_INVALID_INPUT if totals differ or are 0)
+ */
+enum crypto_status decrypt_gamma_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    uint32_t seed
+);
+
+/**
+ * @brief Encrypt using gamma cipher on several threads
+ * 
+ * Data columns are split into slices, each thread seeks PRNG
+ * to its own slice and writes a disjoint part of the output.
+ * Result is identical to encrypt_gamma.
+ * Small inputs are processed on the calling thread only.
+ * 
+ * @param plaintext Input bytes
+ * @param plaintext_len Data length
+ * @param seed PRNG seed
+ * @param threads Maximum number of threads (0 = number of online CPUs)
+ * @param ciphertext Output buffer
+ * @return Status code
+ */
+enum crypto_status encrypt_gamma_parallel(
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    size_t threads,
+    unsigned char** ciphertext
+);
+
+/**
+ * @brief Decrypt using gamma cipher on several threads
+ * 
+ * @param ciphertext Input bytes
+ * @param ciphertext_len Data length
+ * @param seed PRNG seed (same as encryption)
+ * @param threads Maximum number of threads (0 = number of online CPUs)
+ * @param plaintext Output buffer
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_parallel(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    size_t threads,
+    unsigned char** plaintext
+);
+
+/**
+ * @brief Encrypt batch of messages using gamma cipher
+ * 
+ * Each message has its own seed. Gamma sequences of several messages
+ * are generated side by side in SIMD lanes (AVX2 when available),
+ * messages of different lengths are scheduled onto free lanes.
+ * Output of every message is identical to encrypt_gamma.
+ * 
+ * @param plaintexts Array of count input buffers
+ * @param lengths Array of count data lengths (each > 0)
+ * @param seeds Array of count PRNG seeds
+ * @param count Number of messages
+ * @param ciphertexts Array of count output pointers (each caller must free)
+ * @return Status code, on error no output buffers are left allocated
+ */
+enum crypto_status encrypt_gamma_batch(
+    const unsigned char* const* plaintexts,
+    const size_t* lengths,
+    const uint32_t* seeds,
+    size_t count,
+    unsigned char** ciphertexts
+);
+
+/**
+ * @brief Decrypt batch of messages using gamma cipher
+ * 
+ * @param ciphertexts Array of count input buffers
+ * @param lengths Array of count data lengths (each > 0)
+ * @param seeds Array of count PRNG seeds (same as encryption)
+ * @param count Number of messages
+ * @param plaintexts Array of count output pointers (each caller must free)
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_batch(
+    const unsigned char* const* ciphertexts,
+    const size_t* lengths,
+    const uint32_t* seeds,
+    size_t count,
+    unsigned char** plaintexts
+);
+
+/**
+ * @brief Encrypt using gamma cipher with selected generator
+ * 
+ * Generator output words are used as the gamma bit stream,
+ * bit matrix transposition is the same as in encrypt_gamma.
+ * GAMMA_GEN_XORSHIFT32 gives exactly encrypt_gamma output.
+ * ChaCha20 uses AVX2 and AES-CTR uses AES-NI when available,
+ * results do not depend on the CPU.
+ * 
+ * @param plaintext Input bytes
+ * @param plaintext_len Data length
+ * @param seed PRNG seed
+ * @param generator Gamma generator
+ * @param ciphertext Output buffer
+ * @return Status code (CRYPTO_ERROR_INVALID_KEY for unknown generator)
+ */
+enum crypto_status encrypt_gamma_gen(
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    enum gamma_generator generator,
+    unsigned char** ciphertext
+);
+
+/**
+ * @brief Decrypt using gamma cipher with selected generator
+ * 
+ * @param ciphertext Input bytes
+ * @param ciphertext_len Data length
+ * @param seed PRNG seed (same as encryption)
+ * @param generator Gamma generator (same as encryption)
+ * @param plaintext Output buffer
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_gen(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    enum gamma_generator generator,
+    unsigned char** plaintext
+);
+
+/**
+ * @brief Bounded LRU cache of gamma streams keyed by (seed, length class)
+ * 
+ * Length class is the data length rounded up to a power of two (at least 64),
+ * one cached stream serves every length of its class.
+ * Cache is safe to share between threads.
+ */
+struct gamma_cache;
+
+/**
+ * @brief Gamma cache counters
+ */
+struct gamma_cache_stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+    size_t bytes;
+    size_t max_bytes;
+};
+
+/**
+ * @brief Create gamma cache
+ * 
+ * @param max_bytes Memory cap for cached gamma (streams larger than the cap are not cached)
+ * @param cache Output pointer (free with gamma_cache_free)
+ * @return Status code
+ */
+enum crypto_status gamma_cache_create(size_t max_bytes, struct gamma_cache** cache);
+
+/**
+ * @brief Free gamma cache
+ * 
+ * No call may be using the cache at this point.
+ * 
+ * @param cache Cache to free (NULL is ignored)
+ */
+void gamma_cache_free(struct gamma_cache* cache);
+
+/**
+ * @brief Read cache counters
+ * 
+ * @param cache Gamma cache
+ * @param stats Output counters
+ * @return Status code
+ */
+enum crypto_status gamma_cache_get_stats(struct gamma_cache* cache, struct gamma_cache_stats* stats);
+
+/**
+ * @brief Encrypt using gamma cipher with cached gamma
+ * 
+ * On a hit only the transposed XOR is performed.
+ * Result is identical to encrypt_gamma.
+ * 
+ * @param cache Gamma cache
+ * @param plaintext Input bytes
+ * @param plaintext_len Data length
+ * @param seed PRNG seed
+ * @param ciphertext Output buffer
+ * @return Status code
+ */
+enum crypto_status encrypt_gamma_cached(
+    struct gamma_cache* cache,
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    unsigned char** ciphertext
+);
+
+/**
+ * @brief Decrypt using gamma cipher with cached gamma
+ * 
+ * @param cache Gamma cache
+ * @param ciphertext Input bytes
+ * @param ciphertext_len Data length
+ * @param seed PRNG seed (same as encryption)
+ * @param plaintext Output buffer
+ * @return Status code
+ */
+enum crypto_status decrypt_gamma_cached(
+    struct gamma_cache* cache,
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    unsigned char** plaintext
+);
+
+/**
+ * @brief Recover gamma seeds from known plaintext (crib)
+ * 
+ * Every gamma bit is a linear function of the 32-bit PRNG state over GF(2),
+ * so each known plaintext bit gives one linear equation. The system is
+ * solved by Gaussian elimination instead of searching all 2^32 seeds;
+ * 4-5 crib bytes are usually enough for a unique answer.
+ * Seeds 0 and 2463534242 produce the same gamma, both are reported.
+ * 
+ * @param ciphertext Whole ciphertext
+ * @param ciphertext_len Ciphertext length
+ * @param crib Known plaintext bytes
+ * @param crib_len Crib length
+ * @param crib_offset Position of the crib in the plaintext
+ * @param seeds Output array for matching seeds (may be NULL if max_seeds is 0)
+ * @param max_seeds Capacity of seeds array
+ * @param seed_count Output: total number of matching seeds (may exceed max_seeds)
+ * @return Status code
+ */
+enum crypto_status gamma_recover_seed(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    const unsigned char* crib,
+    size_t crib_len,
+    size_t crib_offset,
+    uint32_t* seeds,
+    size_t max_seeds,
+    uint64_t* seed_count
+);
+
 #endif
\ No newline at end of file
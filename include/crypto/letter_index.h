@@ -0,0 +1,93 @@
+#ifndef CRYPTO_LETTER_INDEX_H
+#define CRYPTO_LETTER_INDEX_H
+
+#include "core.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file letter_index.h
+ * @brief Letter-position index for random access into Trithemius and
+ *        Vigenere texts.
+ * 
+ * The shift of every letter depends on the number of letters before it.
+ * The index stores that number at fixed byte strides, so the position of
+ * any byte offset is found from one entry plus a scan of less than one
+ * stride. Letter counts do not change under encryption, so the index of
+ * a ciphertext equals the index of its plaintext.
+ */
+
+/**
+ * @brief Cumulative letter counts: counts[k] = letters in text[0 .. k * stride)
+ */
+struct letter_index {
+    size_t stride;
+    size_t text_len;
+    size_t count;
+    uint64_t* counts;
+};
+
+/**
+ * @brief Default byte stride (8 bytes of index per 4 KiB of text)
+ */
+#define LETTER_INDEX_DEFAULT_STRIDE 4096
+
+/**
+ * @brief Builds index of text in one pass.
+ * 
+ * @param text Text (plaintext or ciphertext). Must not be NULL.
+ * @param text_len Text length.
+ * @param stride Bytes between entries (0 = LETTER_INDEX_DEFAULT_STRIDE).
+ * @param index Index to fill; release with letter_index_free.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status letter_index_build(
+    const char* text,
+    size_t text_len,
+    size_t stride,
+    struct letter_index* index
+);
+
+/**
+ * @brief Finds number of letters before byte offset.
+ * 
+ * @param index Index of text.
+ * @param text Indexed text.
+ * @param offset Byte offset (0 to text_len).
+ * @param letter_pos Output: letters in text[0 .. offset).
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if offset is out of range.
+ */
+enum crypto_status letter_index_position(
+    const struct letter_index* index,
+    const char* text,
+    size_t offset,
+    size_t* letter_pos
+);
+
+/**
+ * @brief Writes index to sidecar file.
+ * 
+ * @param index Index to save.
+ * @param path Output file path.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_EXECUTION on I/O failure.
+ */
+enum crypto_status letter_index_save(const struct letter_index* index, const char* path);
+
+/**
+ * @brief Reads index from sidecar file.
+ * 
+ * @param path Index file path.
+ * @param index Index to fill; release with letter_index_free.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT for a
+ *         malformed file, CRYPTO_ERROR_EXECUTION on I/O failure.
+ */
+enum crypto_status letter_index_load(const char* path, struct letter_index* index);
+
+/**
+ * @brief Releases index memory.
+ * 
+ * @param index Index (may be NULL).
+ */
+void letter_index_free(struct letter_index* index);
+
+#endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define CRYPTO_POLYBIUS_H
 
 #include "core.h"
+#include <stddef.h>
 
 /**
  * @file polybius.h
@@ -18,9 +19,9 @@
  * Converts each letter to coordinate pair (row, column).
  * Non-alphabetic characters are skipped.
  * Example: A -> 11, B -> 12, etc.
+ * Uses the alphabetic square; see polybius_ctx_init for keyed squares.
  *
  * @param plaintext Input string to encrypt. Must not be NULL.
- * @param key Optional key for square permutation (unused in basic version, pass 0).
  * @param ciphertext Pointer to output buffer.
  * @return CRYPTO_SUCCESS on success, error code otherwise.
  */
@@ -33,10 +34,56 @@ enum crypto_status encrypt_polybius(const char* plaintext, char** ciphertext);
  * Input must be valid numeric pairs.
  *
  * @param ciphertext Input string with coordinate pairs.
- * @param key Optional key used during encryption (pass 0 for basic version).
  * @param plaintext Pointer to output buffer.
  * @return CRYPTO_SUCCESS on success, error code otherwise.
  */
 enum crypto_status decrypt_polybius(const char* ciphertext, char** plaintext);
 
+/**
+ * @brief Polybius square compiled into lookup tables.
+ *
+ * encode maps every byte to its digit pair (row, column), non-letters
+ * to { 0, 0 }. decode maps square index (row - 1) * 5 + (column - 1)
+ * to the letter; it is padded to 32 bytes for vector loads.
+ * Built once per key and shared read-only by any number of messages
+ * and threads.
+ */
+struct polybius_ctx {
+    char encode[256][2];
+    char decode[32];
+};
+
+/**
+ * @brief Builds keyed square.
+ *
+ * Square is filled with the keyword letters in order of first
+ * occurrence (J counted as I), followed by the remaining letters of
+ * the alphabet. Example: "KEYWORD" -> KEYWO RDABC FGHIL MNPQS TUVXZ.
+ *
+ * @param ctx Context to fill. Must not be NULL.
+ * @param keyword Letters only, case insensitive; NULL or "" for the alphabetic square.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_KEY for non-letters.
+ */
+enum crypto_status polybius_ctx_init(struct polybius_ctx* ctx, const char* keyword);
+
+/**
+ * @brief Encrypts plaintext with a prepared square.
+ *
+ * @param ctx Square from polybius_ctx_init.
+ * @param plaintext Input string to encrypt. Must not be NULL.
+ * @param ciphertext Pointer to output buffer.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status encrypt_polybius_ctx(const struct polybius_ctx* ctx, const char* plaintext, char** ciphertext);
+
+/**
+ * @brief Decrypts ciphertext with a prepared square.
+ *
+ * @param ctx Square used for encryption.
+ * @param ciphertext Input string with coordinate pairs.
+ * @param plaintext Pointer to output buffer.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status decrypt_polybius_ctx(const struct polybius_ctx* ctx, const char* ciphertext, char** plaintext);
+
 #endif
\ No newline at end of file
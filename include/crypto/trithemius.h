@@ -2,13 +2,17 @@
 #define CRYPTO_TRITHEMIUS_H
 
 #include "core.h"
+#include <stddef.h>
+#include <sys/uio.h>
+#include "letter_index.h"
 
 /**
  * @file trithemius.h
  * @brief Trithemius cipher implementation.
  *
  * Progressive key cipher where the shift increases with each character.
- * Formula: shift = key + position
+ * Formula: shift = (key + position) mod 26, exact for any key and
+ * position (no int overflow near INT_MAX or INT_MIN).
  * Only alphabetic characters (A-Z, a-z) are encrypted.
  */
 
@@ -38,4 +42,153 @@ enum crypto_status encrypt_trithemius(const char* plaintext, int key, char** cip
  */
 enum crypto_status decrypt_trithemius(const char* ciphertext, int key, char** plaintext);
 
+/**
+ * @brief Encrypts scatter/gather buffers using Trithemius cipher.
+ *
+ * Input segments are processed as one text: letter position carries
+ * over segment boundaries. Output segments may have any layout with
+ * the same total length (no terminators), and may be the input itself.
+ *
+ * @param input Input segments.
+ * @param input_count Number of input segments.
+ * @param output Output segments.
+ * @param output_count Number of output segments.
+ * @param key Initial shift value.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if totals differ.
+ */
+enum crypto_status encrypt_trithemius_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+);
+
+/**
+ * @brief Decrypts scatter/gather buffers using Trithemius cipher.
+ *
+ * @param input Input segments.
+ * @param input_count Number of input segments.
+ * @param output Output segments.
+ * @param output_count Number of output segments.
+ * @param key Initial shift value used during encryption.
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if totals differ.
+ */
+enum crypto_status decrypt_trithemius_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+);
+
+/**
+ * @brief Encrypts plaintext using Trithemius cipher on several threads.
+ *
+ * Text is split into chunks. Letters of every chunk are counted first,
+ * so each thread knows the letter position its chunk starts at.
+ * Result is identical to encrypt_trithemius.
+ * Small inputs are processed on the calling thread only.
+ *
+ * @param plaintext Input string to encrypt. Must not be NULL.
+ * @param key Initial shift value.
+ * @param threads Maximum number of threads (0 = number of online CPUs).
+ * @param ciphertext Pointer to output buffer.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status encrypt_trithemius_parallel(const char* plaintext, int key, size_t threads, char** ciphertext);
+
+/**
+ * @brief Decrypts ciphertext using Trithemius cipher on several threads.
+ *
+ * @param ciphertext Input string to decrypt.
+ * @param key Initial shift value used during encryption.
+ * @param threads Maximum number of threads (0 = number of online CPUs).
+ * @param plaintext Pointer to output buffer.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status decrypt_trithemius_parallel(const char* ciphertext, int key, size_t threads, char** plaintext);
+
+/**
+ * @brief Streaming Trithemius state.
+ *
+ * letter_pos is the number of letters processed so far (plus the
+ * starting offset); saving it allows resuming the stream later.
+ */
+struct trithemius_stream_ctx {
+    int key;
+    int direction;
+    size_t letter_pos;
+};
+
+/**
+ * @brief Starts streaming Trithemius transformation.
+ *
+ * Concatenated chunk outputs equal encrypt_trithemius / decrypt_trithemius
+ * output of the whole text.
+ *
+ * @param ctx Stream state to initialize. Must not be NULL.
+ * @param key Initial shift value.
+ * @param decrypt 0 to encrypt, nonzero to decrypt.
+ * @param letter_offset Letters already processed before the first chunk
+ *        (0 for a new stream, saved letter_pos to resume).
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status trithemius_stream_init(
+    struct trithemius_stream_ctx* ctx,
+    int key,
+    int decrypt,
+    size_t letter_offset
+);
+
+/**
+ * @brief Transforms next chunk of the stream.
+ *
+ * @param ctx Stream state.
+ * @param input Chunk characters (no terminator needed).
+ * @param input_len Chunk length (any size).
+ * @param output Output buffer of input_len characters (may equal input).
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status trithemius_stream_update(
+    struct trithemius_stream_ctx* ctx,
+    const char* input,
+    size_t input_len,
+    char* output
+);
+
+/**
+ * @brief Finishes streaming Trithemius transformation, clearing the state.
+ *
+ * @param ctx Stream state.
+ * @return CRYPTO_SUCCESS on success, error code otherwise.
+ */
+enum crypto_status trithemius_stream_final(struct trithemius_stream_ctx* ctx);
+
+/**
+ * @brief Decrypts part of Trithemius ciphertext without the text before it.
+ *
+ * Letter position of offset is taken from the index; without an index
+ * the letters before offset are counted.
+ *
+ * @param ciphertext Whole ciphertext (no terminator needed).
+ * @param ciphertext_len Ciphertext length.
+ * @param index Letter index of the ciphertext (or its plaintext), or NULL.
+ * @param key Initial shift value used during encryption.
+ * @param offset Byte offset of the range.
+ * @param length Range length (> 0).
+ * @param plaintext Pointer to output buffer (length characters, NUL-terminated).
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if the range
+ *         or the index does not match the ciphertext.
+ */
+enum crypto_status decrypt_trithemius_range(
+    const char* ciphertext,
+    size_t ciphertext_len,
+    const struct letter_index* index,
+    int key,
+    size_t offset,
+    size_t length,
+    char** plaintext
+);
+
 #endif
\ No newline at end of file
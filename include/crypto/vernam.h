@@ -11,6 +11,8 @@
 
 #include "core.h"
 #include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
 
 /**
  * @brief Encrypt using Vernam cipher
@@ -53,4 +55,311 @@ enum crypto_status decrypt_vernam(
     unsigned char** result
 );
 
+/**
+ * @brief XOR data with key into caller-provided buffer
+ * 
+ * Uses the widest SIMD kernel available at runtime (AVX-512, AVX2, SSE2),
+ * with a portable fallback. From the stream threshold on, output is
+ * written with non-temporal stores (see vernam_set_stream_threshold).
+ * Output may be the same buffer as data (in-place), but must not
+ * partially overlap it.
+ * 
+ * @param data Input bytes
+ * @param data_len Data length
+ * @param key Key bytes
+ * @param key_len Key length (must be >= data_len)
+ * @param output Buffer of at least data_len bytes
+ * @return Status code
+ */
+enum crypto_status vernam_xor(
+    const unsigned char* data,
+    size_t data_len,
+    const unsigned char* key,
+    size_t key_len,
+    unsigned char* output
+);
+
+/**
+ * @brief Encrypt scatter/gather buffers using Vernam cipher
+ * 
+ * Input segments are processed as one message: key offset carries
+ * over segment boundaries. Output segments may have any layout with
+ * the same total length, and may be the input itself.
+ * 
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param key Key bytes
+ * @param key_len Key length (must be >= total length)
+ * @return Status code (CRYPTO_ERROR_INVALID_INPUT if totals differ)
+ */
+enum crypto_status encrypt_vernam_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const unsigned char* key,
+    size_t key_len
+);
+
+/**
+ * @brief Decrypt scatter/gather buffers using Vernam cipher
+ * 
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param key Key bytes
+ * @param key_len Key length (must be >= total length)
+ * @return Status code (CRYPTO_ERROR_INVALID_INPUT if totals differ)
+ */
+enum crypto_status decrypt_vernam_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const unsigned char* key,
+    size_t key_len
+);
+
+/**
+ * @brief Set data size from which vernam_xor bypasses the cache
+ * 
+ * Large outputs are written with non-temporal (streaming) stores and
+ * prefetched loads, so they do not evict the working set of other code.
+ * Default is 8 MiB; 0 streams always, SIZE_MAX never. Applies process-wide,
+ * also to encrypt_vernam, file and pad functions, and to gamma output
+ * (by total message length).
+ * 
+ * @param bytes Threshold in bytes
+ */
+void vernam_set_stream_threshold(size_t bytes);
+
+/**
+ * @brief Get data size from which vernam_xor bypasses the cache
+ * 
+ * @return Threshold in bytes
+ */
+size_t vernam_get_stream_threshold(void);
+
+/**
+ * @brief XOR file with key file into output file
+ * 
+ * Files are memory-mapped window by window (no read/write copies),
+ * with sequential access hints. Output is created or truncated to
+ * the data size and must be neither the data file nor the key file
+ * (CRYPTO_ERROR_INVALID_INPUT).
+ * 
+ * @param data_path Input file
+ * @param key_path Key (pad) file, at least as long as input
+ * @param output_path Output file
+ * @return Status code (CRYPTO_ERROR_EXECUTION on I/O failure)
+ */
+enum crypto_status vernam_xor_file(
+    const char* data_path,
+    const char* key_path,
+    const char* output_path
+);
+
+/**
+ * @brief XOR file with key file in place
+ * 
+ * @param path File rewritten through a shared mapping
+ * @param key_path Key (pad) file, at least as long as file, not path itself
+ * @return Status code (CRYPTO_ERROR_EXECUTION on I/O failure)
+ */
+enum crypto_status vernam_xor_file_in_place(const char* path, const char* key_path);
+
+/**
+ * @brief Generate random key into caller-provided buffer
+ * 
+ * Bytes come from the kernel CSPRNG: getrandom() in large batches on
+ * Linux, /dev/urandom elsewhere.
+ * 
+ * @param key Output buffer
+ * @param key_len Number of bytes (> 0)
+ * @return Status code (CRYPTO_ERROR_EXECUTION if no randomness source works)
+ */
+enum crypto_status vernam_generate_key(unsigned char* key, size_t key_len);
+
+/**
+ * @brief Generate random pad file on several threads
+ * 
+ * File is created (mode 0600) and must not exist yet, so a live pad is
+ * never overwritten. Every thread fills its own part with random bytes
+ * using its own buffer and writes it with large aligned pwrite() calls.
+ * Data is flushed to disk (fdatasync) before success is returned, so no
+ * zero-filled holes survive a crash. On failure the partly written file
+ * is removed.
+ * 
+ * @param path Pad file (must not exist)
+ * @param size Pad size in bytes (> 0)
+ * @param threads Requested threads (0 = online CPUs)
+ * @return Status code (CRYPTO_ERROR_EXECUTION if path exists)
+ */
+enum crypto_status vernam_generate_key_file(const char* path, uint64_t size, size_t threads);
+
+/**
+ * @brief One-time pad store over a pad file
+ * 
+ * Every encryption reserves pad bytes no other message has used. Each
+ * store leases ranges of the pad by advancing a high-water mark kept in
+ * a separate state file, synced to disk once per lease, and hands out
+ * reservations from its lease with a lock-free compare-and-swap. Leases
+ * start small and double up to 1 MiB, so disk syncs are rare and the
+ * store may be used from many threads at once, and from several
+ * processes opening the same files. Pad bytes leased but not used when
+ * a process crashes, or when another store leased after them, are
+ * skipped and never used.
+ */
+struct vernam_pad;
+
+/**
+ * @brief Open pad store
+ * 
+ * State file is created if missing; creation is atomic, so processes
+ * opening the same new state file at once share one offset. An existing
+ * state file must belong to a pad of the same size.
+ * 
+ * @param pad_path Pad (key material) file, not empty
+ * @param state_path State file holding consumption offset
+ * @param pad Output store, free with vernam_pad_close
+ * @return Status code
+ */
+enum crypto_status vernam_pad_open(const char* pad_path, const char* state_path, struct vernam_pad** pad);
+
+/**
+ * @brief Close pad store
+ * 
+ * Unused end of the lease is given back if no other store leased
+ * after it.
+ * 
+ * @param pad Store (NULL is ignored)
+ */
+void vernam_pad_close(struct vernam_pad* pad);
+
+/**
+ * @brief Get number of pad bytes not yet reserved
+ * 
+ * @param pad Store
+ * @param remaining Output byte count
+ * @return Status code
+ */
+enum crypto_status vernam_pad_remaining(struct vernam_pad* pad, uint64_t* remaining);
+
+/**
+ * @brief Encrypt with fresh pad bytes
+ * 
+ * Reserves data_len bytes of pad, never handed out again. Waits for
+ * the disk only when a new lease is needed.
+ * 
+ * @param pad Store
+ * @param data Input bytes
+ * @param data_len Data length (> 0)
+ * @param pad_offset Output pad offset used, needed for decryption
+ * @param result Output
+ * @return Status code (CRYPTO_ERROR_INVALID_KEY if pad is exhausted)
+ */
+enum crypto_status vernam_pad_encrypt(
+    struct vernam_pad* pad,
+    const unsigned char* data,
+    size_t data_len,
+    uint64_t* pad_offset,
+    unsigned char** result
+);
+
+/**
+ * @brief Decrypt with pad bytes reserved at pad_offset
+ * 
+ * @param pad Store
+ * @param data Input bytes
+ * @param data_len Data length (> 0)
+ * @param pad_offset Pad offset returned by vernam_pad_encrypt
+ * @param result Output
+ * @return Status code (CRYPTO_ERROR_INVALID_KEY if range was never reserved)
+ */
+enum crypto_status vernam_pad_decrypt(
+    struct vernam_pad* pad,
+    const unsigned char* data,
+    size_t data_len,
+    uint64_t pad_offset,
+    unsigned char** result
+);
+
+/**
+ * @brief Two ciphertexts that appear to share key material
+ */
+struct vernam_reuse_pair {
+    size_t first;
+    size_t second;
+    size_t overlap;
+};
+
+/**
+ * @brief Best crib position found for one pair
+ * 
+ * Crib placed at position in one message reveals bytes
+ * c1 ^ c2 ^ crib of the other message there.
+ */
+struct vernam_crib_hit {
+    size_t position;
+    long score;
+    int found;
+};
+
+/**
+ * @brief Find ciphertext pairs encrypted with the same key (two-time pad)
+ * 
+ * Detects reuse of key from the same offset between messages of mostly
+ * ASCII plaintext: at most 1 in 16 bytes, and 2 of the first 32, may be
+ * non-ASCII. Ciphertexts are bucketed 28 times by 24-bit keys taken
+ * from a sketch of their first 32 bytes; buckets of unrelated messages
+ * stay near one entry, so cost grows like sorting, not like comparing
+ * all pairs. Ciphertexts shorter than 32 bytes are skipped.
+ * 
+ * @param ciphertexts Ciphertexts
+ * @param lengths Ciphertext lengths
+ * @param count Number of ciphertexts
+ * @param pairs Output pairs (first < second), may be NULL if max_pairs is 0
+ * @param max_pairs Capacity of pairs
+ * @param pair_count Output total number of pairs found (may exceed max_pairs)
+ * @return Status code
+ */
+enum crypto_status vernam_find_key_reuse(
+    const unsigned char* const* ciphertexts,
+    const size_t* lengths,
+    size_t count,
+    struct vernam_reuse_pair* pairs,
+    size_t max_pairs,
+    uint64_t* pair_count
+);
+
+/**
+ * @brief Crib-drag candidate pairs on several threads
+ * 
+ * For every pair, the crib is XOR-ed with c1 ^ c2 at every position and
+ * the result scored for English likelihood (letter frequencies, spaces).
+ * 
+ * @param ciphertexts Ciphertexts
+ * @param lengths Ciphertext lengths
+ * @param pairs Pairs to examine
+ * @param pair_count Number of pairs
+ * @param crib Guessed plaintext fragment
+ * @param crib_len Crib length (> 0)
+ * @param threads Requested threads (0 = online CPUs)
+ * @param hits Output best hit per pair (found = 0 if overlap is shorter than crib)
+ * @return Status code
+ */
+enum crypto_status vernam_crib_drag(
+    const unsigned char* const* ciphertexts,
+    const size_t* lengths,
+    const struct vernam_reuse_pair* pairs,
+    size_t pair_count,
+    const unsigned char* crib,
+    size_t crib_len,
+    size_t threads,
+    struct vernam_crib_hit* hits
+);
+
 #endif
\ No newline at end of file
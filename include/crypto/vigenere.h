@@ -2,6 +2,9 @@
 #define CRYPTO_VIGENERE_H
 
 #include "core.h"
+#include <stddef.h>
+#include <sys/uio.h>
+#include "letter_index.h"
 
 /**
  * @brief Encrypt plaintext using Vigenere cipher
@@ -28,4 +31,156 @@ enum crypto_status encrypt_vigenere(const char* plaintext, const char* key, char
  */
 enum crypto_status decrypt_vigenere(const char* ciphertext, const char* key, char** plaintext);
 
+/**
+ * @brief Encrypt scatter/gather buffers using Vigenere cipher
+ * 
+ * Input segments are processed as one text: key position carries
+ * over segment boundaries. Output segments may have any layout with
+ * the same total length (no terminators), and may be the input itself.
+ * 
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param key Keyword (only letters, case insensitive)
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if totals differ
+ */
+enum crypto_status encrypt_vigenere_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const char* key
+);
+
+/**
+ * @brief Decrypt scatter/gather buffers using Vigenere cipher
+ * 
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param key Keyword used for encryption
+ * @return CRYPTO_SUCCESS on success, CRYPTO_ERROR_INVALID_INPUT if totals differ
+ */
+enum crypto_status decrypt_vigenere_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const char* key
+);
+
+/**
+ * @brief Encrypt plaintext using Vigenere cipher on several threads
+ * 
+ * Text is split into chunks. Letters of every chunk are counted first,
+ * so each thread knows the key position its chunk starts at.
+ * Result is identical to encrypt_vigenere.
+ * Small inputs are processed on the calling thread only.
+ * 
+ * @param plaintext Input text
+ * @param key Keyword (only letters, case insensitive)
+ * @param threads Maximum number of threads (0 = number of online CPUs)
+ * @param ciphertext Output buffer
+ * @return Status code
+ */
+enum crypto_status encrypt_vigenere_parallel(const char* plaintext, const char* key, size_t threads, char** ciphertext);
+
+/**
+ * @brief Decrypt ciphertext using Vigenere cipher on several threads
+ * 
+ * @param ciphertext Encrypted text
+ * @param key Keyword used for encryption
+ * @param threads Maximum number of threads (0 = number of online CPUs)
+ * @param plaintext Output buffer
+ * @return Status code
+ */
+enum crypto_status decrypt_vigenere_parallel(const char* ciphertext, const char* key, size_t threads, char** plaintext);
+
+/**
+ * @brief Streaming Vigenere state
+ * 
+ * key_pos is the number of letters processed so far (plus the
+ * starting offset); saving it allows resuming the stream later.
+ * The keyword is not copied and must stay valid until final.
+ */
+struct vigenere_stream_ctx {
+    const char* key;
+    size_t key_len;
+    size_t key_pos;
+    int direction;
+};
+
+/**
+ * @brief Start streaming Vigenere transformation
+ * 
+ * Concatenated chunk outputs equal encrypt_vigenere / decrypt_vigenere
+ * output of the whole text.
+ * 
+ * @param ctx Stream state to initialize
+ * @param key Keyword (only letters, case insensitive)
+ * @param decrypt 0 to encrypt, nonzero to decrypt
+ * @param letter_offset Letters already processed before the first chunk
+ *        (0 for a new stream, saved key_pos to resume)
+ * @return Status code
+ */
+enum crypto_status vigenere_stream_init(
+    struct vigenere_stream_ctx* ctx,
+    const char* key,
+    int decrypt,
+    size_t letter_offset
+);
+
+/**
+ * @brief Transform next chunk of the stream
+ * 
+ * @param ctx Stream state
+ * @param input Chunk characters (no terminator needed)
+ * @param input_len Chunk length (any size)
+ * @param output Output buffer of input_len characters (may equal input)
+ * @return Status code
+ */
+enum crypto_status vigenere_stream_update(
+    struct vigenere_stream_ctx* ctx,
+    const char* input,
+    size_t input_len,
+    char* output
+);
+
+/**
+ * @brief Finish streaming Vigenere transformation
+ * 
+ * Clears the state.
+ * 
+ * @param ctx Stream state
+ * @return Status code
+ */
+enum crypto_status vigenere_stream_final(struct vigenere_stream_ctx* ctx);
+
+/**
+ * @brief Decrypt part of Vigenere ciphertext without the text before it
+ * 
+ * Key position of offset is taken from the index; without an index
+ * the letters before offset are counted.
+ * 
+ * @param ciphertext Whole ciphertext (no terminator needed)
+ * @param ciphertext_len Ciphertext length
+ * @param index Letter index of the ciphertext (or its plaintext), or NULL
+ * @param key Keyword used for encryption
+ * @param offset Byte offset of the range
+ * @param length Range length (> 0)
+ * @param plaintext Output buffer (length characters, NUL-terminated)
+ * @return Status code
+ */
+enum crypto_status decrypt_vigenere_range(
+    const char* ciphertext,
+    size_t ciphertext_len,
+    const struct letter_index* index,
+    const char* key,
+    size_t offset,
+    size_t length,
+    char** plaintext
+);
+
 #endif
\ No newline at end of file
@@ -15,5 +15,7 @@
 #include "crypto/vigenere.h"
 #include "crypto/vernam.h"
 #include "crypto/gamma.h"
+#include "crypto/letter_index.h"
+#include "crypto/crack.h"
 
 #endif
\ No newline at end of file
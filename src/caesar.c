@@ -1,4 +1,5 @@
 #include "crypto/caesar.h"
+#include "iov_internal.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -38,6 +39,150 @@ static char shift_char(char c, int key)
     return (c - base + key) % 26 + base;
 }
 
+/**
+ * @brief Fills engine for given key.
+ * 
+ * Sets shift to the key reduced to 0-25 and table to the shifted
+ * letter for A-Z and a-z, every other byte mapping to itself.
+ */
+static void caesar_prepare(struct caesar_engine* engine, int key)
+{
+    engine->shift = (unsigned char)(((key % 26) + 26) % 26);
+    
+    for (int c = 0; c < 256; c++)
+    {
+        char ch = (char)c;
+        engine->table[c] = (unsigned char)(is_letter(ch) ? shift_char(ch, engine->shift) : ch);
+    }
+}
+
+/**
+ * @brief Translates bytes through the table.
+ */
+static void caesar_lut(const struct caesar_engine* engine, const unsigned char* in, unsigned char* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = engine->table[in[i]];
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CAESAR_X86 1
+#include <immintrin.h>
+
+/**
+ * @brief SIMD kernels: compare, add, conditional subtract.
+ * 
+ * For t = (c | 32) - 'a', c is a letter iff t < 26 (unsigned).
+ * Letters get +shift, or +shift - 26 when t >= 26 - shift (wraparound).
+ * Processes whole vectors only, returns bytes done.
+ */
+__attribute__((target("sse2")))
+static size_t caesar_sse2(const struct caesar_engine* engine, const unsigned char* in, unsigned char* out, size_t len)
+{
+    const __m128i case_bit = _mm_set1_epi8(32);
+    const __m128i a = _mm_set1_epi8('a');
+    const __m128i last = _mm_set1_epi8(25);
+    const __m128i wrap_from = _mm_set1_epi8((char)(26 - engine->shift));
+    const __m128i shift = _mm_set1_epi8((char)engine->shift);
+    const __m128i twenty_six = _mm_set1_epi8(26);
+    size_t i = 0;
+    
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i c = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i t = _mm_sub_epi8(_mm_or_si128(c, case_bit), a);
+        __m128i letter = _mm_cmpeq_epi8(_mm_min_epu8(t, last), t);
+        __m128i wrap = _mm_cmpeq_epi8(_mm_max_epu8(t, wrap_from), t);
+        __m128i delta = _mm_sub_epi8(shift, _mm_and_si128(wrap, twenty_six));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_add_epi8(c, _mm_and_si128(letter, delta)));
+    }
+    
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t caesar_avx2(const struct caesar_engine* engine, const unsigned char* in, unsigned char* out, size_t len)
+{
+    const __m256i case_bit = _mm256_set1_epi8(32);
+    const __m256i a = _mm256_set1_epi8('a');
+    const __m256i last = _mm256_set1_epi8(25);
+    const __m256i wrap_from = _mm256_set1_epi8((char)(26 - engine->shift));
+    const __m256i shift = _mm256_set1_epi8((char)engine->shift);
+    const __m256i twenty_six = _mm256_set1_epi8(26);
+    size_t i = 0;
+    
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i t = _mm256_sub_epi8(_mm256_or_si256(c, case_bit), a);
+        __m256i letter = _mm256_cmpeq_epi8(_mm256_min_epu8(t, last), t);
+        __m256i wrap = _mm256_cmpeq_epi8(_mm256_max_epu8(t, wrap_from), t);
+        __m256i delta = _mm256_sub_epi8(shift, _mm256_and_si256(wrap, twenty_six));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_add_epi8(c, _mm256_and_si256(letter, delta)));
+    }
+    
+    return i;
+}
+
+__attribute__((target("avx512bw")))
+static size_t caesar_avx512(const struct caesar_engine* engine, const unsigned char* in, unsigned char* out, size_t len)
+{
+    const __m512i case_bit = _mm512_set1_epi8(32);
+    const __m512i a = _mm512_set1_epi8('a');
+    const __m512i wrap_from = _mm512_set1_epi8((char)(26 - engine->shift));
+    const __m512i shift = _mm512_set1_epi8((char)engine->shift);
+    const __m512i wrapped = _mm512_set1_epi8((char)(engine->shift - 26));
+    size_t i = 0;
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i c = _mm512_loadu_si512((const void*)(in + i));
+        __m512i t = _mm512_sub_epi8(_mm512_or_si512(c, case_bit), a);
+        __mmask64 letter = _mm512_cmplt_epu8_mask(t, _mm512_set1_epi8(26));
+        __mmask64 wrap = _mm512_mask_cmpge_epu8_mask(letter, t, wrap_from);
+        __m512i r = _mm512_mask_add_epi8(c, letter, c, shift);
+        r = _mm512_mask_add_epi8(r, wrap, c, wrapped);
+        _mm512_storeu_si512((void*)(out + i), r);
+    }
+    
+    return i;
+}
+#endif
+
+typedef size_t (*caesar_kernel)(const struct caesar_engine* engine, const unsigned char* in, unsigned char* out, size_t len);
+
+/**
+ * @brief Picks widest SIMD kernel supported by this CPU (NULL if none).
+ */
+static caesar_kernel select_kernel(void)
+{
+#ifdef CAESAR_X86
+    if (__builtin_cpu_supports("avx512bw"))
+        return caesar_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return caesar_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return caesar_sse2;
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Shifts letters of len characters from in to out.
+ * 
+ * @param engine Prepared key
+ * @param in Input characters
+ * @param out Output characters (may equal in)
+ * @param len Number of characters
+ */
+static void caesar_run(const struct caesar_engine* engine, const char* in, char* out, size_t len)
+{
+    caesar_kernel kernel = select_kernel();
+    size_t done = kernel ? kernel(engine, (const unsigned char*)in, (unsigned char*)out, len) : 0;
+    
+    caesar_lut(engine, (const unsigned char*)in + done, (unsigned char*)out + done, len - done);
+}
+
 enum crypto_status encrypt_caesar(const char* plaintext, int key, char** ciphertext)
 {
     if (!plaintext || !ciphertext)
@@ -49,14 +194,9 @@ enum crypto_status encrypt_caesar(const char* plaintext, int key, char** ciphert
     if (!result)
         return CRYPTO_ERROR_MEMORY;
     
-
-    for (size_t i = 0; i < len; i++)
-    {
-        if (is_letter(plaintext[i]))
-            result[i] = shift_char(plaintext[i], key);
-        else  
-            result[i] = plaintext[i];
-    }
+    struct caesar_engine engine;
+    caesar_prepare(&engine, key);
+    caesar_run(&engine, plaintext, result, len);
     
     result[len] = '\0';
     
@@ -67,5 +207,92 @@ enum crypto_status encrypt_caesar(const char* plaintext, int key, char** ciphert
 
 enum crypto_status decrypt_caesar(const char* ciphertext, int key, char** plaintext)
 {
-    return encrypt_caesar(ciphertext, -key, plaintext);
+    return encrypt_caesar(ciphertext, -(key % 26), plaintext);
+}
+
+/**
+ * @brief Applies Caesar shift over scatter/gather vectors.
+ */
+static enum crypto_status caesar_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+)
+{
+    struct iov_cursor cursor;
+    struct caesar_engine engine;
+    size_t total;
+    const unsigned char* in;
+    unsigned char* out;
+    size_t run;
+    
+    enum crypto_status status = iov_cursor_init(&cursor, input, input_count, output, output_count, &total);
+    if (status != CRYPTO_SUCCESS)
+        return status;
+    
+    caesar_prepare(&engine, key);
+    
+    while ((run = iov_cursor_next(&cursor, &in, &out)) > 0)
+        caesar_run(&engine, (const char*)in, (char*)out, run);
+    
+    return CRYPTO_SUCCESS;
+}
+
+enum crypto_status encrypt_caesar_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+)
+{
+    return caesar_iov(input, input_count, output, output_count, key % 26);
+}
+
+enum crypto_status decrypt_caesar_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+)
+{
+    return caesar_iov(input, input_count, output, output_count, -(key % 26));
+}
+
+enum crypto_status caesar_stream_init(struct caesar_stream_ctx* ctx, int key, int decrypt)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    caesar_prepare(&ctx->engine, decrypt ? -(key % 26) : key % 26);
+    
+    return CRYPTO_SUCCESS;
+}
+
+enum crypto_status caesar_stream_update(
+    struct caesar_stream_ctx* ctx,
+    const char* input,
+    size_t input_len,
+    char* output
+)
+{
+    if (!ctx || !input || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    caesar_run(&ctx->engine, input, output, input_len);
+    
+    return CRYPTO_SUCCESS;
+}
+
+enum crypto_status caesar_stream_final(struct caesar_stream_ctx* ctx)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    memset(ctx, 0, sizeof(*ctx));
+    
+    return CRYPTO_SUCCESS;
 }
\ No newline at end of file
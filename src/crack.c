@@ -0,0 +1,268 @@
+#include "crypto/crack.h"
+#include "parallel_internal.h"
+
+/**
+ * @brief Smallest number of texts worth a separate thread
+ */
+#define CRACK_MIN_SLICE 1024
+
+/**
+ * @brief English letter frequencies A-Z (percent)
+ */
+static const double english[26] = {
+    8.167, 1.492, 2.782, 4.253, 12.702, 2.228, 2.015, 6.094, 6.966,
+    0.153, 0.772, 4.025, 2.406, 6.749, 7.507, 1.929, 0.095, 5.987,
+    6.327, 9.056, 2.758, 0.978, 2.360, 0.150, 1.974, 0.074
+};
+
+/**
+ * @brief Counts letters, each shifted back by its letter position if progressive.
+ * 
+ * @param text Input string
+ * @param progressive 1 for Trithemius, 0 for Caesar
+ * @param counts Output: counts of (letter - shift) mod 26
+ * @return Number of letters
+ */
+static size_t letter_histogram(const char* text, int progressive, size_t counts[26])
+{
+    size_t total = 0;
+    unsigned pos = 0;
+    
+    for (int j = 0; j < 26; j++)
+        counts[j] = 0;
+    
+    for (size_t i = 0; text[i]; i++)
+    {
+        unsigned t = (unsigned char)((text[i] | 32) - 'a');
+        if (t >= 26)
+            continue;
+        
+        counts[(t + 26 - pos) % 26]++;
+        total++;
+        
+        if (progressive)
+            pos = pos == 25 ? 0 : pos + 1;
+    }
+    
+    return total;
+}
+
+/**
+ * @brief Normalizes model to probabilities.
+ * 
+ * @return 0 on success, -1 if a frequency is not positive
+ */
+static int load_model(const double* model, double probabilities[26])
+{
+    const double* source = model ? model : english;
+    double sum = 0.0;
+    
+    for (int j = 0; j < 26; j++)
+    {
+        if (!(source[j] > 0.0))
+            return -1;
+        sum += source[j];
+    }
+    
+    for (int j = 0; j < 26; j++)
+        probabilities[j] = source[j] / sum;
+    
+    return 0;
+}
+
+/**
+ * @brief Chi-squared score of every key from one histogram.
+ * 
+ * Key k decrypts counted value v to letter (v - k) mod 26,
+ * so plaintext letter j has count counts[(j + k) mod 26].
+ */
+static void score_keys(const size_t counts[26], size_t total, const double probabilities[26], double scores[26])
+{
+    for (int k = 0; k < 26; k++)
+    {
+        double chi = 0.0;
+        
+        for (int j = 0; j < 26; j++)
+        {
+            double expected = (double)total * probabilities[j];
+            double diff = (double)counts[(j + k) % 26] - expected;
+            chi += diff * diff / expected;
+        }
+        
+        scores[k] = chi;
+    }
+}
+
+/**
+ * @brief Rank all keys of one text, best first
+ */
+static enum crypto_status crack_ranked(
+    const char* ciphertext,
+    const double* model,
+    int progressive,
+    struct crack_candidate ranked[26]
+)
+{
+    if (!ciphertext || !ranked)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    double probabilities[26];
+    if (load_model(model, probabilities) != 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    size_t counts[26];
+    size_t total = letter_histogram(ciphertext, progressive, counts);
+    if (total == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    double scores[26];
+    score_keys(counts, total, probabilities, scores);
+    
+    for (int k = 0; k < 26; k++)
+    {
+        int i = k;
+        
+        while (i > 0 && ranked[i - 1].score > scores[k])
+        {
+            ranked[i] = ranked[i - 1];
+            i--;
+        }
+        
+        ranked[i].key = k;
+        ranked[i].score = scores[k];
+    }
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Rank Caesar keys of ciphertext
+ */
+enum crypto_status crack_caesar(const char* ciphertext, const double* model, struct crack_candidate ranked[26])
+{
+    return crack_ranked(ciphertext, model, 0, ranked);
+}
+
+/**
+ * @brief Rank Trithemius keys of ciphertext
+ */
+enum crypto_status crack_trithemius(const char* ciphertext, const double* model, struct crack_candidate ranked[26])
+{
+    return crack_ranked(ciphertext, model, 1, ranked);
+}
+
+/**
+ * @brief Work item of one thread: texts offset .. offset + length - 1
+ */
+struct crack_slice {
+    const char* const* ciphertexts;
+    const double* probabilities;
+    int progressive;
+    int* keys;
+    size_t offset;
+    size_t length;
+};
+
+/**
+ * @brief Find best key of every text in the slice (-1 without letters)
+ */
+static void* crack_slice_run(void* arg)
+{
+    struct crack_slice* slice = (struct crack_slice*)arg;
+    
+    for (size_t i = slice->offset; i < slice->offset + slice->length; i++)
+    {
+        size_t counts[26];
+        double scores[26];
+        size_t total = letter_histogram(slice->ciphertexts[i], slice->progressive, counts);
+        
+        if (total == 0)
+        {
+            slice->keys[i] = -1;
+            continue;
+        }
+        
+        score_keys(counts, total, slice->probabilities, scores);
+        
+        int best = 0;
+        for (int k = 1; k < 26; k++)
+        {
+            if (scores[k] < scores[best])
+                best = k;
+        }
+        
+        slice->keys[i] = best;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Find best key of many texts on several threads
+ */
+static enum crypto_status crack_batch(
+    const char* const* ciphertexts,
+    size_t count,
+    const double* model,
+    size_t threads,
+    int progressive,
+    int* keys
+)
+{
+    if ((!ciphertexts || !keys) && count)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!ciphertexts[i])
+            return CRYPTO_ERROR_NULL_POINTER;
+    }
+    
+    double probabilities[26];
+    if (load_model(model, probabilities) != 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    struct crack_slice slices[PARALLEL_MAX_THREADS];
+    size_t count_threads = parallel_thread_count(count, threads, CRACK_MIN_SLICE);
+    size_t step = (count + count_threads - 1) / count_threads;
+    
+    for (size_t i = 0; i < count_threads; i++)
+    {
+        size_t offset = i * step < count ? i * step : count;
+        size_t end = offset + step < count ? offset + step : count;
+        
+        slices[i] = (struct crack_slice){ ciphertexts, probabilities, progressive, keys, offset, end - offset };
+    }
+    
+    parallel_run(crack_slice_run, slices, sizeof(struct crack_slice), count_threads);
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Find best Caesar key of many texts on several threads
+ */
+enum crypto_status crack_caesar_batch(
+    const char* const* ciphertexts,
+    size_t count,
+    const double* model,
+    size_t threads,
+    int* keys
+)
+{
+    return crack_batch(ciphertexts, count, model, threads, 0, keys);
+}
+
+/**
+ * @brief Find best Trithemius key of many texts on several threads
+ */
+enum crypto_status crack_trithemius_batch(
+    const char* const* ciphertexts,
+    size_t count,
+    const double* model,
+    size_t threads,
+    int* keys
+)
+{
+    return crack_batch(ciphertexts, count, model, threads, 1, keys);
+}
\ No newline at end of file
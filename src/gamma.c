@@ -1,77 +1,393 @@
 #include "crypto/gamma.h"
+#include "gamma_internal.h"
+#include "iov_internal.h"
+#include "vernam_internal.h"
+#include "crypto/vernam.h"
 #include <stdlib.h>
 #include <string.h>
 
 /**
- * @brief Xorshift32 PRNG
+ * @brief Gamma bytes prepared before one XOR kernel call (multiple of 64)
  */
-static uint32_t prng_state;
+#define GAMMA_XOR_CHUNK 4096
 
-static void prng_init(uint32_t seed)
+/**
+ * @brief Xorshift32 PRNG initial state for seed
+ * 
+ * Seed 0 maps to GAMMA_ZERO_SEED_STATE.
+ */
+uint32_t gamma_seed_state(uint32_t seed)
 {
-    prng_state = seed ? seed : 2463534242U;
+    return seed ? seed : GAMMA_ZERO_SEED_STATE;
 }
 
-static uint8_t prng_next_bit(void)
+/**
+ * @brief Generate up to 64 gamma bits packed into one word
+ * 
+ * Each xorshift round contributes its lowest bit.
+ * Bit i of the result is the i-th generated gamma bit.
+ * 
+ * @param state PRNG state (advanced by count rounds)
+ * @param count Number of bits to generate (1-64)
+ * @return Packed gamma bits
+ */
+static uint64_t xorshift_bits(uint32_t* state, unsigned count)
 {
-    prng_state ^= prng_state << 13;
-    prng_state ^= prng_state >> 17;
-    prng_state ^= prng_state << 5;
-    return prng_state & 1;
+    uint32_t x = *state;
+    uint64_t bits = 0;
+    
+    for (unsigned i = 0; i < count; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        bits |= (uint64_t)(x & 1) << i;
+    }
+    
+    *state = x;
+    return bits;
 }
 
 /**
- * @brief Convert bytes to bit matrix
+ * @brief Apply GF(2) matrix to vector
  * 
- * @param data Input bytes
- * @param len Number of bytes
- * @param matrix Output bit matrix
+ * @param matrix 32 columns, matrix[i] = image of bit i
+ * @param x Input vector
+ * @return matrix * x
  */
-static void bytes_to_matrix(const unsigned char* data, size_t len, uint8_t matrix[8][len])
+static uint32_t gf2_apply(const uint32_t matrix[32], uint32_t x)
 {
-    for (size_t byte_idx = 0; byte_idx < len; byte_idx++)
+    uint32_t result = 0;
+    
+    for (unsigned i = 0; x; i++, x >>= 1)
+    {
+        if (x & 1)
+            result ^= matrix[i];
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Square GF(2) matrix in place
+ * 
+ * @param matrix 32 columns, replaced by matrix * matrix
+ */
+static void gf2_square(uint32_t matrix[32])
+{
+    uint32_t result[32];
+    
+    for (unsigned i = 0; i < 32; i++)
+        result[i] = gf2_apply(matrix, matrix[i]);
+    
+    memcpy(matrix, result, sizeof(result));
+}
+
+/**
+ * @brief Build matrix T of one xorshift round
+ * 
+ * @param matrix Output: 32 columns, matrix[i] = round applied to bit i
+ */
+static void xorshift_matrix(uint32_t matrix[32])
+{
+    for (unsigned i = 0; i < 32; i++)
+    {
+        uint32_t column = 1U << i;
+        column ^= column << 13;
+        column ^= column >> 17;
+        column ^= column << 5;
+        matrix[i] = column;
+    }
+}
+
+/**
+ * @brief Advance PRNG state by given number of rounds
+ * 
+ * Xorshift round is linear over GF(2), i.e. a 32x32 bit matrix T.
+ * Skipping n rounds multiplies the state by T^n, computed by
+ * repeated squaring in O(log n) matrix operations.
+ * Short distances are stepped directly, which is cheaper.
+ * 
+ * @param state PRNG state
+ * @param steps Number of rounds to skip
+ */
+static void xorshift_skip(uint32_t* state, uint64_t steps)
+{
+    uint32_t x = *state;
+    
+    if (steps < 4096)
     {
-        unsigned char byte = data[byte_idx];
+        for (uint64_t i = 0; i < steps; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+        }
+        
+        *state = x;
+        return;
+    }
+    
+    uint32_t power[32];
+    
+    xorshift_matrix(power);
+    
+    while (steps)
+    {
+        if (steps & 1)
+            x = gf2_apply(power, x);
+        
+        steps >>= 1;
+        if (steps)
+            gf2_square(power);
+    }
+    
+    *state = x;
+}
+
+/**
+ * @brief Compute matrix of given number of xorshift rounds
+ */
+void gamma_skip_matrix(uint64_t steps, uint32_t matrix[32])
+{
+    uint32_t power[32];
+    
+    xorshift_matrix(power);
+    
+    for (unsigned i = 0; i < 32; i++)
+        matrix[i] = 1U << i;
+    
+    while (steps)
+    {
+        if (steps & 1)
+        {
+            for (unsigned i = 0; i < 32; i++)
+                matrix[i] = gf2_apply(power, matrix[i]);
+        }
         
-        for (size_t bit_idx = 0; bit_idx < 8; bit_idx++)
-            matrix[bit_idx][byte_idx] = (byte >> bit_idx) & 1;
+        steps >>= 1;
+        if (steps)
+            gf2_square(power);
     }
 }
 
 /**
- * @brief Convert bit matrix back to bytes
+ * @brief Read 64 bits starting at arbitrary bit position
  * 
- * @param matrix Input bit matrix
- * @param len Number of bytes
- * @param data Output bytes
+ * @param words Packed bit stream (must have one word of padding at the end)
+ * @param pos Bit position of the first bit
+ * @return Bits pos..pos+63, bit 0 of result = bit pos of stream
  */
-static void matrix_to_bytes(size_t len, uint8_t matrix[8][len], unsigned char* data)
+static uint64_t load_bits64(const uint64_t* words, size_t pos)
 {
-    for (size_t byte_idx = 0; byte_idx < len; byte_idx++)
+    size_t word = pos >> 6;
+    unsigned shift = pos & 63;
+    
+    if (shift == 0)
+        return words[word];
+    
+    return (words[word] >> shift) | (words[word + 1] << (64 - shift));
+}
+
+/**
+ * @brief Transpose 8x8 bit matrix stored in one word
+ * 
+ * Bit (8 * row + col) moves to bit (8 * col + row).
+ * 
+ * @param x Matrix, one byte per row
+ * @return Transposed matrix
+ */
+static uint64_t transpose8x8(uint64_t x)
+{
+    uint64_t t;
+    
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    
+    return x;
+}
+
+/**
+ * @brief Turn gamma rows of up to 64 columns into gamma bytes
+ * 
+ * XOR-ing a row of the bit matrix equals XOR-ing every byte with
+ * the transposed gamma, so only the gamma is transposed (8 columns at a time)
+ * and later applied to whole bytes.
+ * 
+ * @param rows Gamma bits of rows 0-7, bit i = column i
+ * @param count Number of bytes (columns), at most 64
+ * @param key Output gamma bytes
+ */
+static void block_gamma(const uint64_t rows[8], size_t count, unsigned char* key)
+{
+    for (size_t col = 0; col < count; col += 8)
+    {
+        uint64_t x = 0;
+        
+        for (unsigned row = 0; row < 8; row++)
+            x |= ((rows[row] >> col) & 0xFF) << (8 * row);
+        
+        x = transpose8x8(x);
+        
+        size_t n = count - col < 8 ? count - col : 8;
+        for (size_t i = 0; i < n; i++)
+            key[col + i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+/**
+ * @brief Generate packed gamma bit stream
+ */
+void gamma_generate_bits(uint32_t* state, uint64_t* gamma, size_t bits)
+{
+    size_t words = bits / 64;
+    unsigned tail = bits % 64;
+    
+    for (size_t i = 0; i < words; i++)
+        gamma[i] = xorshift_bits(state, 64);
+    
+    if (tail)
+        gamma[words] = xorshift_bits(state, tail);
+}
+
+/**
+ * @brief Apply packed gamma bit stream to data
+ * 
+ * Row r of the bit matrix is XOR-ed with stream bits r * len .. r * len + len - 1.
+ * Gamma bytes are prepared a chunk at a time and applied by the Vernam
+ * XOR kernel, with non-temporal stores from the stream threshold on.
+ */
+void gamma_apply_bits(const uint64_t* gamma, const unsigned char* in, size_t len, unsigned char* out)
+{
+    unsigned char key[GAMMA_XOR_CHUNK];
+    int stream = len >= vernam_get_stream_threshold();
+    
+    for (size_t start = 0; start < len; start += GAMMA_XOR_CHUNK)
     {
-        unsigned char byte = 0;
+        size_t chunk = len - start < GAMMA_XOR_CHUNK ? len - start : GAMMA_XOR_CHUNK;
         
-        for (size_t bit_idx = 0; bit_idx < 8; bit_idx++)
+        for (size_t col = 0; col < chunk; col += 64)
         {
-            if (matrix[bit_idx][byte_idx])
-                byte |= (1 << bit_idx);
+            uint64_t rows[8];
+            
+            for (size_t row = 0; row < 8; row++)
+                rows[row] = load_bits64(gamma, row * len + start + col);
+            
+            block_gamma(rows, chunk - col < 64 ? chunk - col : 64, key + col);
         }
         
-        data[byte_idx] = byte;
+        vernam_xor_kernel(in + start, key, out + start, chunk, stream);
     }
 }
 
 /**
- * @brief Encrypt using gamma cipher
+ * @brief Apply gamma with transposition (encryption and decryption are identical)
+ * 
+ * Gamma for row r covers bits r * len .. r * len + len - 1 of the PRNG stream.
+ * The stream is generated word by word and applied in blocks of 64 columns.
+ * 
+ * @param state PRNG state (advanced by 8 * len rounds)
+ * @param in Input bytes
+ * @param len Data length
+ * @param out Output buffer (len bytes)
+ * @return Status code
  */
-enum crypto_status encrypt_gamma(
+static enum crypto_status gamma_transform(uint32_t* state, const unsigned char* in, size_t len, unsigned char* out)
+{
+    if (len > SIZE_MAX / 8)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    size_t total_bits = len * 8;
+    size_t words = total_bits / 64;
+    
+    uint64_t* gamma = (uint64_t*)calloc(words + 2, sizeof(uint64_t));
+    if (!gamma)
+        return CRYPTO_ERROR_MEMORY;
+    
+    gamma_generate_bits(state, gamma, total_bits);
+    
+    gamma_apply_bits(gamma, in, len, out);
+    
+    free(gamma);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Apply gamma directly to bytes (no transposition)
+ * 
+ * Every PRNG state is used as 4 gamma bytes, least significant first.
+ * 
+ * @param state PRNG state (advanced by (len + 3) / 4 rounds)
+ * @param in Input bytes
+ * @param len Data length
+ * @param out Output buffer (len bytes)
+ */
+static void gamma_direct(uint32_t* state, const unsigned char* in, size_t len, unsigned char* out)
+{
+    unsigned char key[GAMMA_XOR_CHUNK];
+    int stream = len >= vernam_get_stream_threshold();
+    uint32_t x = *state;
+    
+    for (size_t start = 0; start < len; start += GAMMA_XOR_CHUNK)
+    {
+        size_t chunk = len - start < GAMMA_XOR_CHUNK ? len - start : GAMMA_XOR_CHUNK;
+        
+        for (size_t i = 0; i < chunk; i += 4)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            
+            size_t n = chunk - i < 4 ? chunk - i : 4;
+            for (size_t j = 0; j < n; j++)
+                key[i + j] = (unsigned char)(x >> (8 * j));
+        }
+        
+        vernam_xor_kernel(in + start, key, out + start, chunk, stream);
+    }
+    
+    *state = x;
+}
+
+/**
+ * @brief Initialize gamma context
+ */
+enum crypto_status gamma_ctx_init(struct gamma_ctx* ctx, uint32_t seed)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    ctx->state = gamma_seed_state(seed);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Advance gamma context by given number of gamma bits
+ */
+enum crypto_status gamma_ctx_skip(struct gamma_ctx* ctx, uint64_t bits)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    xorshift_skip(&ctx->state, bits);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt using gamma cipher with caller-owned context
+ */
+enum crypto_status encrypt_gamma_ctx(
+    struct gamma_ctx* ctx,
     const unsigned char* plaintext,
     size_t plaintext_len,
-    uint32_t seed,
     unsigned char** ciphertext
 )
 {
-    if (!plaintext || !ciphertext)
+    if (!ctx || !plaintext || !ciphertext)
         return CRYPTO_ERROR_NULL_POINTER;
     
     if (plaintext_len == 0)
@@ -81,27 +397,64 @@ enum crypto_status encrypt_gamma(
     if (!result)
         return CRYPTO_ERROR_MEMORY;
     
-    uint8_t matrix[8][plaintext_len];
+    enum crypto_status status = gamma_transform(&ctx->state, plaintext, plaintext_len, result);
+    if (status != CRYPTO_SUCCESS)
+    {
+        free(result);
+        return status;
+    }
+    
+    *ciphertext = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Decrypt using gamma cipher with caller-owned context
+ */
+enum crypto_status decrypt_gamma_ctx(
+    struct gamma_ctx* ctx,
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    unsigned char** plaintext
+)
+{
+    if (!ctx || !ciphertext || !plaintext)
+        return CRYPTO_ERROR_NULL_POINTER;
     
-    bytes_to_matrix(plaintext, plaintext_len, matrix);
+    if (ciphertext_len == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
     
-    prng_init(seed);
+    unsigned char* result = (unsigned char*)malloc(ciphertext_len);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
     
-    for (size_t row = 0; row < 8; row++)
+    enum crypto_status status = gamma_transform(&ctx->state, ciphertext, ciphertext_len, result);
+    if (status != CRYPTO_SUCCESS)
     {
-        for (size_t col = 0; col < plaintext_len; col++)
-        {
-            uint8_t gamma_bit = prng_next_bit();
-            matrix[row][col] ^= gamma_bit;
-        }
+        free(result);
+        return status;
     }
     
-    matrix_to_bytes(plaintext_len, matrix, result);
-    
-    *ciphertext = result;
+    *plaintext = result;
     return CRYPTO_SUCCESS;
 }
 
+/**
+ * @brief Encrypt using gamma cipher
+ */
+enum crypto_status encrypt_gamma(
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    unsigned char** ciphertext
+)
+{
+    struct gamma_ctx ctx;
+    
+    gamma_ctx_init(&ctx, seed);
+    return encrypt_gamma_ctx(&ctx, plaintext, plaintext_len, ciphertext);
+}
+
 /**
  * @brief Decrypt using gamma cipher
  */
@@ -112,33 +465,267 @@ enum crypto_status decrypt_gamma(
     unsigned char** plaintext
 )
 {
-    if (!ciphertext || !plaintext)
+    struct gamma_ctx ctx;
+    
+    gamma_ctx_init(&ctx, seed);
+    return decrypt_gamma_ctx(&ctx, ciphertext, ciphertext_len, plaintext);
+}
+
+/**
+ * @brief Apply gamma in selected mode
+ */
+static enum crypto_status gamma_transform_mode(
+    const unsigned char* in,
+    size_t len,
+    uint32_t seed,
+    enum gamma_mode mode,
+    unsigned char** out
+)
+{
+    if (!in || !out)
         return CRYPTO_ERROR_NULL_POINTER;
     
-    if (ciphertext_len == 0)
+    if (len == 0 || (mode != GAMMA_MODE_CLASSIC && mode != GAMMA_MODE_DIRECT))
         return CRYPTO_ERROR_INVALID_INPUT;
     
-    unsigned char* result = (unsigned char*)malloc(ciphertext_len);
+    if (mode == GAMMA_MODE_CLASSIC)
+        return encrypt_gamma(in, len, seed, out);
+    
+    unsigned char* result = (unsigned char*)malloc(len);
     if (!result)
         return CRYPTO_ERROR_MEMORY;
     
-    uint8_t matrix[8][ciphertext_len];
+    uint32_t state = gamma_seed_state(seed);
+    gamma_direct(&state, in, len, result);
     
-    bytes_to_matrix(ciphertext, ciphertext_len, matrix);
+    *out = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt using gamma cipher in selected mode
+ */
+enum crypto_status encrypt_gamma_mode(
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    enum gamma_mode mode,
+    unsigned char** ciphertext
+)
+{
+    return gamma_transform_mode(plaintext, plaintext_len, seed, mode, ciphertext);
+}
+
+/**
+ * @brief Decrypt using gamma cipher in selected mode
+ */
+enum crypto_status decrypt_gamma_mode(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    enum gamma_mode mode,
+    unsigned char** plaintext
+)
+{
+    return gamma_transform_mode(ciphertext, ciphertext_len, seed, mode, plaintext);
+}
+
+/**
+ * @brief Start streaming gamma transformation
+ */
+enum crypto_status gamma_stream_init(struct gamma_stream_ctx* ctx, uint32_t seed, size_t total_len)
+{
+    return gamma_stream_init_at(ctx, seed, total_len, 0);
+}
+
+/**
+ * @brief Start streaming gamma transformation at byte offset
+ * 
+ * Row r state is seeked to bit r * total_len + offset.
+ */
+enum crypto_status gamma_stream_init_at(
+    struct gamma_stream_ctx* ctx,
+    uint32_t seed,
+    size_t total_len,
+    size_t offset
+)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (total_len == 0 || total_len > SIZE_MAX / 8 || offset > total_len)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    uint32_t state = gamma_seed_state(seed);
+    
+    xorshift_skip(&state, offset);
+    
+    ctx->row_state[0] = state;
+    for (size_t row = 1; row < 8; row++)
+    {
+        xorshift_skip(&state, total_len);
+        ctx->row_state[row] = state;
+    }
+    
+    ctx->total_len = total_len;
+    ctx->position = offset;
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Transform next chunk of the stream
+ * 
+ * Each row state generates gamma for the chunk columns only,
+ * so memory use does not depend on total length.
+ */
+enum crypto_status gamma_stream_update(
+    struct gamma_stream_ctx* ctx,
+    const unsigned char* input,
+    size_t input_len,
+    unsigned char* output
+)
+{
+    if (!ctx || !input || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (input_len > ctx->total_len - ctx->position)
+        return CRYPTO_ERROR_INVALID_INPUT;
     
-    prng_init(seed);
+    unsigned char key[GAMMA_XOR_CHUNK];
+    int stream = ctx->total_len >= vernam_get_stream_threshold();
     
-    for (size_t row = 0; row < 8; row++)
+    for (size_t start = 0; start < input_len; start += GAMMA_XOR_CHUNK)
     {
-        for (size_t col = 0; col < ciphertext_len; col++)
+        size_t chunk = input_len - start < GAMMA_XOR_CHUNK ? input_len - start : GAMMA_XOR_CHUNK;
+        
+        for (size_t col = 0; col < chunk; col += 64)
         {
-            uint8_t gamma_bit = prng_next_bit();
-            matrix[row][col] ^= gamma_bit;
+            size_t count = chunk - col < 64 ? chunk - col : 64;
+            uint64_t rows[8];
+            
+            for (size_t row = 0; row < 8; row++)
+                rows[row] = xorshift_bits(&ctx->row_state[row], (unsigned)count);
+            
+            block_gamma(rows, count, key + col);
         }
+        
+        vernam_xor_kernel(input + start, key, output + start, chunk, stream);
     }
     
-    matrix_to_bytes(ciphertext_len, matrix, result);
+    ctx->position += input_len;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Finish streaming gamma transformation
+ */
+enum crypto_status gamma_stream_final(struct gamma_stream_ctx* ctx)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    enum crypto_status status = ctx->position == ctx->total_len
+        ? CRYPTO_SUCCESS
+        : CRYPTO_ERROR_INVALID_INPUT;
+    
+    memset(ctx, 0, sizeof(*ctx));
+    return status;
+}
+
+/**
+ * @brief Decrypt byte range of gamma ciphertext
+ */
+enum crypto_status decrypt_gamma_range(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    size_t offset,
+    size_t length,
+    unsigned char** plaintext
+)
+{
+    if (!ciphertext || !plaintext)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (length == 0 || offset > ciphertext_len || length > ciphertext_len - offset)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    struct gamma_stream_ctx ctx;
+    enum crypto_status status = gamma_stream_init_at(&ctx, seed, ciphertext_len, offset);
+    if (status != CRYPTO_SUCCESS)
+        return status;
+    
+    unsigned char* result = (unsigned char*)malloc(length);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    gamma_stream_update(&ctx, ciphertext + offset, length, result);
     
     *plaintext = result;
     return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Apply gamma over scatter/gather vectors
+ * 
+ * One stream over the total length, so keystream position carries
+ * over segment boundaries.
+ */
+static enum crypto_status gamma_transform_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    uint32_t seed
+)
+{
+    struct iov_cursor cursor;
+    struct gamma_stream_ctx ctx;
+    size_t total;
+    const unsigned char* in;
+    unsigned char* out;
+    size_t run;
+    
+    enum crypto_status status = iov_cursor_init(&cursor, input, input_count, output, output_count, &total);
+    if (status != CRYPTO_SUCCESS)
+        return status;
+    
+    status = gamma_stream_init(&ctx, seed, total);
+    
+    while (status == CRYPTO_SUCCESS && (run = iov_cursor_next(&cursor, &in, &out)) > 0)
+        status = gamma_stream_update(&ctx, in, run, out);
+    
+    if (status == CRYPTO_SUCCESS)
+        return gamma_stream_final(&ctx);
+    
+    return status;
+}
+
+/**
+ * @brief Encrypt scatter/gather buffers using gamma cipher
+ */
+enum crypto_status encrypt_gamma_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    uint32_t seed
+)
+{
+    return gamma_transform_iov(input, input_count, output, output_count, seed);
+}
+
+/**
+ * @brief Decrypt scatter/gather buffers using gamma cipher
+ */
+enum crypto_status decrypt_gamma_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    uint32_t seed
+)
+{
+    return gamma_transform_iov(input, input_count, output, output_count, seed);
 }
\ No newline at end of file
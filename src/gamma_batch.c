@@ -0,0 +1,268 @@
+#include "crypto/gamma.h"
+#include "gamma_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GAMMA_BATCH_AVX2 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Number of messages processed side by side
+ */
+#define GAMMA_LANES 8
+
+/**
+ * @brief One lane of the batch: message currently assigned to it
+ */
+struct gamma_lane {
+    size_t message;
+    size_t position;
+    size_t total_bits;
+    uint64_t* gamma;
+    int active;
+};
+
+/**
+ * @brief Generate 32 gamma bits for each lane (portable version)
+ * 
+ * @param state PRNG states of all lanes
+ * @param bits Output: bit i of bits[lane] = i-th generated bit of lane
+ */
+static void lanes_next32_scalar(uint32_t state[GAMMA_LANES], uint32_t bits[GAMMA_LANES])
+{
+    for (unsigned lane = 0; lane < GAMMA_LANES; lane++)
+    {
+        uint32_t x = state[lane];
+        uint32_t acc = 0;
+        
+        for (unsigned i = 0; i < 32; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            acc |= (x & 1) << i;
+        }
+        
+        state[lane] = x;
+        bits[lane] = acc;
+    }
+}
+
+#ifdef GAMMA_BATCH_AVX2
+/**
+ * @brief Generate 32 gamma bits for each lane (AVX2 version)
+ * 
+ * All eight xorshift states live in one register.
+ * Bits are shifted in from the top, so after 32 rounds
+ * the first generated bit ends up in bit 0.
+ */
+__attribute__((target("avx2")))
+static void lanes_next32_avx2(uint32_t state[GAMMA_LANES], uint32_t bits[GAMMA_LANES])
+{
+    __m256i x = _mm256_loadu_si256((const __m256i*)state);
+    __m256i acc = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    
+    for (unsigned i = 0; i < 32; i++)
+    {
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+        acc = _mm256_or_si256(_mm256_srli_epi32(acc, 1),
+                              _mm256_slli_epi32(_mm256_and_si256(x, one), 31));
+    }
+    
+    _mm256_storeu_si256((__m256i*)state, x);
+    _mm256_storeu_si256((__m256i*)bits, acc);
+}
+#endif
+
+/**
+ * @brief Pick lane generator for this CPU
+ */
+static void (*select_lanes_next32(void))(uint32_t*, uint32_t*)
+{
+#ifdef GAMMA_BATCH_AVX2
+    if (__builtin_cpu_supports("avx2"))
+        return lanes_next32_avx2;
+#endif
+    return lanes_next32_scalar;
+}
+
+/**
+ * @brief Validate batch arguments
+ */
+static enum crypto_status check_batch(
+    const unsigned char* const* inputs,
+    const size_t* lengths,
+    const uint32_t* seeds,
+    size_t count,
+    unsigned char** outputs
+)
+{
+    if (!inputs || !lengths || !seeds || !outputs)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (count == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!inputs[i])
+            return CRYPTO_ERROR_NULL_POINTER;
+        
+        if (lengths[i] == 0 || lengths[i] > SIZE_MAX / 8 - 128)
+            return CRYPTO_ERROR_INVALID_INPUT;
+    }
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Assign next message to lane
+ * 
+ * @return 1 if a message was assigned, 0 if batch is exhausted
+ */
+static int lane_assign(
+    struct gamma_lane* lane,
+    uint32_t* state,
+    size_t* next,
+    size_t count,
+    const size_t* lengths,
+    const uint32_t* seeds
+)
+{
+    if (*next >= count)
+    {
+        lane->active = 0;
+        *state = 1;
+        return 0;
+    }
+    
+    lane->message = (*next)++;
+    lane->position = 0;
+    lane->total_bits = lengths[lane->message] * 8;
+    lane->active = 1;
+    memset(lane->gamma, 0, (lane->total_bits / 64 + 2) * sizeof(uint64_t));
+    *state = gamma_seed_state(seeds[lane->message]);
+    
+    return 1;
+}
+
+/**
+ * @brief Apply gamma to a batch of messages
+ * 
+ * Each lane runs the gamma sequence of one message. When a message
+ * is complete its gamma is applied and the lane takes the next message,
+ * so messages of different lengths keep all lanes busy.
+ */
+static enum crypto_status gamma_transform_batch(
+    const unsigned char* const* inputs,
+    const size_t* lengths,
+    const uint32_t* seeds,
+    size_t count,
+    unsigned char** outputs
+)
+{
+    enum crypto_status status = check_batch(inputs, lengths, seeds, count, outputs);
+    if (status != CRYPTO_SUCCESS)
+        return status;
+    
+    size_t max_len = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        outputs[i] = NULL;
+        if (lengths[i] > max_len)
+            max_len = lengths[i];
+    }
+    
+    struct gamma_lane lanes[GAMMA_LANES];
+    uint32_t state[GAMMA_LANES];
+    uint32_t bits[GAMMA_LANES];
+    size_t words = max_len * 8 / 64 + 2;
+    
+    uint64_t* buffer = (uint64_t*)malloc(words * GAMMA_LANES * sizeof(uint64_t));
+    if (!buffer)
+        return CRYPTO_ERROR_MEMORY;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        outputs[i] = (unsigned char*)malloc(lengths[i]);
+        if (!outputs[i])
+        {
+            for (size_t j = 0; j < i; j++)
+            {
+                free(outputs[j]);
+                outputs[j] = NULL;
+            }
+            free(buffer);
+            return CRYPTO_ERROR_MEMORY;
+        }
+    }
+    
+    void (*next32)(uint32_t*, uint32_t*) = select_lanes_next32();
+    size_t next = 0;
+    size_t active = 0;
+    
+    for (unsigned l = 0; l < GAMMA_LANES; l++)
+    {
+        lanes[l].gamma = buffer + l * words;
+        active += lane_assign(&lanes[l], &state[l], &next, count, lengths, seeds);
+    }
+    
+    while (active)
+    {
+        next32(state, bits);
+        
+        for (unsigned l = 0; l < GAMMA_LANES; l++)
+        {
+            struct gamma_lane* lane = &lanes[l];
+            if (!lane->active)
+                continue;
+            
+            lane->gamma[lane->position / 64] |= (uint64_t)bits[l] << (lane->position % 64);
+            lane->position += 32;
+            
+            if (lane->position < lane->total_bits)
+                continue;
+            
+            gamma_apply_bits(lane->gamma, inputs[lane->message],
+                             lengths[lane->message], outputs[lane->message]);
+            
+            active -= 1 - lane_assign(lane, &state[l], &next, count, lengths, seeds);
+        }
+    }
+    
+    free(buffer);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt batch of messages using gamma cipher
+ */
+enum crypto_status encrypt_gamma_batch(
+    const unsigned char* const* plaintexts,
+    const size_t* lengths,
+    const uint32_t* seeds,
+    size_t count,
+    unsigned char** ciphertexts
+)
+{
+    return gamma_transform_batch(plaintexts, lengths, seeds, count, ciphertexts);
+}
+
+/**
+ * @brief Decrypt batch of messages using gamma cipher
+ */
+enum crypto_status decrypt_gamma_batch(
+    const unsigned char* const* ciphertexts,
+    const size_t* lengths,
+    const uint32_t* seeds,
+    size_t count,
+    unsigned char** plaintexts
+)
+{
+    return gamma_transform_batch(ciphertexts, lengths, seeds, count, plaintexts);
+}
\ No newline at end of file
@@ -0,0 +1,363 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "crypto/gamma.h"
+#include "gamma_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#define GAMMA_CACHE_BUCKETS 1024
+
+/**
+ * @brief Smallest length class (bytes)
+ */
+#define GAMMA_CACHE_MIN_CLASS 64
+
+/**
+ * @brief Cached gamma stream of one (seed, length class) pair
+ * 
+ * Holds 8 * length_class gamma bits, enough for any data length
+ * up to length_class: row r of such data uses bits r * len .. r * len + len - 1.
+ */
+struct gamma_cache_entry {
+    uint32_t seed;
+    size_t length_class;
+    size_t bytes;
+    unsigned refs;
+    int linked;
+    struct gamma_cache_entry* hash_next;
+    struct gamma_cache_entry* lru_prev;
+    struct gamma_cache_entry* lru_next;
+    uint64_t gamma[];
+};
+
+/**
+ * @brief Bounded LRU cache of gamma streams
+ * 
+ * Entries in use by a running call are reference counted,
+ * so eviction never frees gamma that is still being applied.
+ */
+struct gamma_cache {
+    pthread_mutex_t lock;
+    struct gamma_cache_entry* buckets[GAMMA_CACHE_BUCKETS];
+    struct gamma_cache_entry* lru_head;
+    struct gamma_cache_entry* lru_tail;
+    size_t max_bytes;
+    size_t bytes;
+    size_t entries;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+};
+
+/**
+ * @brief Length class for data length: power of two, at least GAMMA_CACHE_MIN_CLASS
+ * 
+ * @return Length class, 0 if length is too large to be cached
+ */
+static size_t length_class(size_t len)
+{
+    size_t cls = GAMMA_CACHE_MIN_CLASS;
+    
+    while (cls < len)
+    {
+        if (cls > SIZE_MAX / 32)
+            return 0;
+        cls <<= 1;
+    }
+    
+    return cls;
+}
+
+static size_t bucket_index(uint32_t seed, size_t cls)
+{
+    uint32_t h = seed * 2654435761U ^ (uint32_t)cls * 40503U;
+    return (h >> 16 ^ h) % GAMMA_CACHE_BUCKETS;
+}
+
+static struct gamma_cache_entry* cache_lookup(struct gamma_cache* cache, uint32_t seed, size_t cls)
+{
+    struct gamma_cache_entry* entry = cache->buckets[bucket_index(seed, cls)];
+    
+    while (entry && (entry->seed != seed || entry->length_class != cls))
+        entry = entry->hash_next;
+    
+    return entry;
+}
+
+static void lru_unlink(struct gamma_cache* cache, struct gamma_cache_entry* entry)
+{
+    if (entry->lru_prev)
+        entry->lru_prev->lru_next = entry->lru_next;
+    else
+        cache->lru_head = entry->lru_next;
+    
+    if (entry->lru_next)
+        entry->lru_next->lru_prev = entry->lru_prev;
+    else
+        cache->lru_tail = entry->lru_prev;
+    
+    entry->lru_prev = entry->lru_next = NULL;
+}
+
+static void lru_push_front(struct gamma_cache* cache, struct gamma_cache_entry* entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    
+    if (cache->lru_head)
+        cache->lru_head->lru_prev = entry;
+    else
+        cache->lru_tail = entry;
+    
+    cache->lru_head = entry;
+}
+
+/**
+ * @brief Remove entry from cache, free it if nobody uses it
+ */
+static void cache_remove(struct gamma_cache* cache, struct gamma_cache_entry* entry)
+{
+    struct gamma_cache_entry** link = &cache->buckets[bucket_index(entry->seed, entry->length_class)];
+    
+    while (*link != entry)
+        link = &(*link)->hash_next;
+    
+    *link = entry->hash_next;
+    lru_unlink(cache, entry);
+    
+    entry->linked = 0;
+    cache->bytes -= entry->bytes;
+    cache->entries--;
+    
+    if (entry->refs == 0)
+        free(entry);
+}
+
+/**
+ * @brief Insert entry, evicting least recently used entries to stay under the cap
+ */
+static void cache_insert(struct gamma_cache* cache, struct gamma_cache_entry* entry)
+{
+    while (cache->lru_tail && cache->bytes + entry->bytes > cache->max_bytes)
+    {
+        cache_remove(cache, cache->lru_tail);
+        cache->evictions++;
+    }
+    
+    size_t index = bucket_index(entry->seed, entry->length_class);
+    entry->hash_next = cache->buckets[index];
+    cache->buckets[index] = entry;
+    entry->linked = 1;
+    
+    lru_push_front(cache, entry);
+    cache->bytes += entry->bytes;
+    cache->entries++;
+}
+
+/**
+ * @brief Drop reference taken by a call
+ */
+static void cache_release(struct gamma_cache* cache, struct gamma_cache_entry* entry)
+{
+    pthread_mutex_lock(&cache->lock);
+    
+    if (--entry->refs == 0 && !entry->linked)
+        free(entry);
+    
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * @brief Find or build cached gamma for (seed, length class)
+ * 
+ * Gamma is generated outside the lock. If two threads miss on the same
+ * key at once, the first inserted stream is kept and the other discarded.
+ * 
+ * @return Referenced entry, NULL if memory allocation failed
+ */
+static struct gamma_cache_entry* cache_acquire(struct gamma_cache* cache, uint32_t seed, size_t cls, size_t bytes)
+{
+    pthread_mutex_lock(&cache->lock);
+    
+    struct gamma_cache_entry* entry = cache_lookup(cache, seed, cls);
+    if (entry)
+    {
+        cache->hits++;
+        entry->refs++;
+        lru_unlink(cache, entry);
+        lru_push_front(cache, entry);
+        pthread_mutex_unlock(&cache->lock);
+        return entry;
+    }
+    
+    cache->misses++;
+    pthread_mutex_unlock(&cache->lock);
+    
+    struct gamma_cache_entry* created = (struct gamma_cache_entry*)malloc(bytes);
+    if (!created)
+        return NULL;
+    
+    size_t bits = cls * 8;
+    uint32_t state = gamma_seed_state(seed);
+    
+    gamma_generate_bits(&state, created->gamma, bits);
+    created->gamma[bits / 64] = 0;
+    
+    created->seed = seed;
+    created->length_class = cls;
+    created->bytes = bytes;
+    created->refs = 1;
+    created->linked = 0;
+    
+    pthread_mutex_lock(&cache->lock);
+    
+    entry = cache_lookup(cache, seed, cls);
+    if (entry)
+    {
+        entry->refs++;
+        free(created);
+    }
+    else
+    {
+        cache_insert(cache, created);
+        entry = created;
+    }
+    
+    pthread_mutex_unlock(&cache->lock);
+    return entry;
+}
+
+/**
+ * @brief Apply gamma taken from cache
+ */
+static enum crypto_status gamma_transform_cached(
+    struct gamma_cache* cache,
+    const unsigned char* in,
+    size_t len,
+    uint32_t seed,
+    unsigned char** out
+)
+{
+    if (!cache || !in || !out)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (len == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    size_t cls = length_class(len);
+    size_t bytes = sizeof(struct gamma_cache_entry) + (cls / 8 + 1) * sizeof(uint64_t);
+    
+    if (cls == 0 || bytes > cache->max_bytes)
+    {
+        pthread_mutex_lock(&cache->lock);
+        cache->misses++;
+        pthread_mutex_unlock(&cache->lock);
+        
+        return encrypt_gamma(in, len, seed, out);
+    }
+    
+    unsigned char* result = (unsigned char*)malloc(len);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    struct gamma_cache_entry* entry = cache_acquire(cache, seed, cls, bytes);
+    if (!entry)
+    {
+        free(result);
+        return CRYPTO_ERROR_MEMORY;
+    }
+    
+    gamma_apply_bits(entry->gamma, in, len, result);
+    cache_release(cache, entry);
+    
+    *out = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Create gamma cache
+ */
+enum crypto_status gamma_cache_create(size_t max_bytes, struct gamma_cache** cache)
+{
+    if (!cache)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    struct gamma_cache* result = (struct gamma_cache*)calloc(1, sizeof(struct gamma_cache));
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    if (pthread_mutex_init(&result->lock, NULL) != 0)
+    {
+        free(result);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    result->max_bytes = max_bytes;
+    
+    *cache = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Free gamma cache
+ */
+void gamma_cache_free(struct gamma_cache* cache)
+{
+    if (!cache)
+        return;
+    
+    while (cache->lru_head)
+        cache_remove(cache, cache->lru_head);
+    
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+/**
+ * @brief Read cache counters
+ */
+enum crypto_status gamma_cache_get_stats(struct gamma_cache* cache, struct gamma_cache_stats* stats)
+{
+    if (!cache || !stats)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    pthread_mutex_lock(&cache->lock);
+    
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->entries = cache->entries;
+    stats->bytes = cache->bytes;
+    stats->max_bytes = cache->max_bytes;
+    
+    pthread_mutex_unlock(&cache->lock);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt using gamma cipher with cached gamma
+ */
+enum crypto_status encrypt_gamma_cached(
+    struct gamma_cache* cache,
+    const unsigned char* plaintext,
+    size_t plaintext_len,
+    uint32_t seed,
+    unsigned char** ciphertext
+)
+{
+    return gamma_transform_cached(cache, plaintext, plaintext_len, seed, ciphertext);
+}
+
+/**
+ * @brief Decrypt using gamma cipher with cached gamma
+ */
+enum crypto_status decrypt_gamma_cached(
+    struct gamma_cache* cache,
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    uint32_t seed,
+    unsigned char** plaintext
+)
+{
+    return gamma_transform_cached(cache, ciphertext, ciphertext_len, seed, plaintext);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**
+ * @file gamma_internal.h
+ * @brief Gamma cipher helpers shared between library sources
+ * 
+ * Not part of the public API.
+ */
+
+#ifndef CRYPTO_GAMMA_INTERNAL_H
+#define CRYPTO_GAMMA_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief PRNG state used for seed 0
+ * 
+ * Zero is a fixed point of xorshift, so it is replaced by this constant.
+ */
+#define GAMMA_ZERO_SEED_STATE 2463534242U
+
+/**
+ * @brief Xorshift32 PRNG initial state for seed
+ * 
+ * @param seed PRNG seed
+ * @return Non-zero PRNG state
+ */
+uint32_t gamma_seed_state(uint32_t seed);
+
+/**
+ * @brief Compute GF(2) matrix of given number of xorshift rounds
+ * 
+ * State after n rounds is the XOR of matrix[i] over set bits i of the
+ * initial state, so every gamma bit is a linear function of the seed.
+ * 
+ * @param steps Number of rounds
+ * @param matrix Output: 32 columns, matrix[i] = image of bit i
+ */
+void gamma_skip_matrix(uint64_t steps, uint32_t matrix[32]);
+
+/**
+ * @brief Generate packed gamma bit stream
+ * 
+ * Bit i of gamma[w] is gamma bit 64 * w + i (generation order).
+ * 
+ * @param state PRNG state (advanced by bits rounds)
+ * @param gamma Output words, at least (bits + 63) / 64
+ * @param bits Number of gamma bits
+ */
+void gamma_generate_bits(uint32_t* state, uint64_t* gamma, size_t bits);
+
+/**
+ * @brief Apply packed gamma bit stream to data
+ * 
+ * Bit i of gamma[w] is gamma bit 64 * w + i (generation order).
+ * 
+ * @param gamma At least 8 * len bits plus one padding word
+ * @param in Input bytes
+ * @param len Data length
+ * @param out Output bytes (may equal in)
+ */
+void gamma_apply_bits(const uint64_t* gamma, const unsigned char* in, size_t len, unsigned char* out);
+
+#endif
\ No newline at end of file
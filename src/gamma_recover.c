@@ -0,0 +1,227 @@
+#include "crypto/gamma.h"
+#include "gamma_internal.h"
+#include <string.h>
+
+/**
+ * @brief Linear system over GF(2) in reduced row echelon form
+ * 
+ * Equation rows[p] has pivot column p and no other pivot columns,
+ * rhs[p] is its right-hand side.
+ */
+struct gf2_system {
+    uint32_t rows[32];
+    uint8_t rhs[32];
+    uint32_t pivots;
+    int inconsistent;
+};
+
+static unsigned parity32(uint32_t x)
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1;
+}
+
+static unsigned popcount32(uint32_t x)
+{
+    unsigned count = 0;
+    
+    for (; x; x &= x - 1)
+        count++;
+    
+    return count;
+}
+
+static unsigned highest_bit(uint32_t x)
+{
+    unsigned bit = 0;
+    
+    while (x >>= 1)
+        bit++;
+    
+    return bit;
+}
+
+/**
+ * @brief Add equation parity(row & state) = value
+ */
+static void system_add(struct gf2_system* sys, uint32_t row, unsigned value)
+{
+    for (unsigned p = 0; p < 32; p++)
+    {
+        if ((sys->pivots >> p & 1) && (row >> p & 1))
+        {
+            row ^= sys->rows[p];
+            value ^= sys->rhs[p];
+        }
+    }
+    
+    if (row == 0)
+    {
+        if (value)
+            sys->inconsistent = 1;
+        return;
+    }
+    
+    unsigned pivot = highest_bit(row);
+    
+    for (unsigned p = 0; p < 32; p++)
+    {
+        if ((sys->pivots >> p & 1) && (sys->rows[p] >> pivot & 1))
+        {
+            sys->rows[p] ^= row;
+            sys->rhs[p] ^= (uint8_t)value;
+        }
+    }
+    
+    sys->rows[pivot] = row;
+    sys->rhs[pivot] = (uint8_t)value;
+    sys->pivots |= 1U << pivot;
+}
+
+/**
+ * @brief Check whether state satisfies all equations
+ */
+static int system_satisfied(const struct gf2_system* sys, uint32_t state)
+{
+    for (unsigned p = 0; p < 32; p++)
+    {
+        if ((sys->pivots >> p & 1) && parity32(sys->rows[p] & state) != sys->rhs[p])
+            return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief Build solution from values of free (non-pivot) columns
+ * 
+ * @param sys Reduced system
+ * @param index Packed values of free columns, lowest free column first
+ * @return Solution state
+ */
+static uint32_t system_solution(const struct gf2_system* sys, uint64_t index)
+{
+    uint32_t state = 0;
+    
+    for (unsigned col = 0; col < 32; col++)
+    {
+        if (!(sys->pivots >> col & 1))
+        {
+            state |= (uint32_t)(index & 1) << col;
+            index >>= 1;
+        }
+    }
+    
+    for (unsigned p = 0; p < 32; p++)
+    {
+        if (sys->pivots >> p & 1)
+        {
+            uint32_t others = sys->rows[p] & ~(1U << p);
+            state |= (uint32_t)(sys->rhs[p] ^ parity32(others & state)) << p;
+        }
+    }
+    
+    return state;
+}
+
+/**
+ * @brief Add equations of known plaintext bytes for one bit row
+ * 
+ * Gamma bit t is the lowest bit of the state after t + 1 rounds,
+ * i.e. parity of (column 0 bits of T^(t+1)) & initial state.
+ * Next column is one more round: every matrix column is stepped once.
+ */
+static void add_row_equations(
+    struct gf2_system* sys,
+    const unsigned char* ciphertext,
+    size_t len,
+    const unsigned char* crib,
+    size_t crib_len,
+    size_t crib_offset,
+    unsigned row
+)
+{
+    uint32_t matrix[32];
+    
+    gamma_skip_matrix((uint64_t)row * len + crib_offset + 1, matrix);
+    
+    for (size_t i = 0; i < crib_len; i++)
+    {
+        uint32_t equation = 0;
+        
+        for (unsigned col = 0; col < 32; col++)
+            equation |= (matrix[col] & 1) << col;
+        
+        unsigned value = ((crib[i] ^ ciphertext[crib_offset + i]) >> row) & 1;
+        system_add(sys, equation, value);
+        
+        for (unsigned col = 0; col < 32; col++)
+        {
+            uint32_t x = matrix[col];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            matrix[col] = x;
+        }
+    }
+}
+
+/**
+ * @brief Recover gamma seeds from known plaintext
+ */
+enum crypto_status gamma_recover_seed(
+    const unsigned char* ciphertext,
+    size_t ciphertext_len,
+    const unsigned char* crib,
+    size_t crib_len,
+    size_t crib_offset,
+    uint32_t* seeds,
+    size_t max_seeds,
+    uint64_t* seed_count
+)
+{
+    if (!ciphertext || !crib || !seed_count || (!seeds && max_seeds))
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (crib_len == 0 || ciphertext_len > SIZE_MAX / 8 ||
+        crib_offset > ciphertext_len || crib_len > ciphertext_len - crib_offset)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    struct gf2_system sys;
+    memset(&sys, 0, sizeof(sys));
+    
+    for (unsigned row = 0; row < 8 && !sys.inconsistent; row++)
+        add_row_equations(&sys, ciphertext, ciphertext_len, crib, crib_len, crib_offset, row);
+    
+    *seed_count = 0;
+    if (sys.inconsistent)
+        return CRYPTO_SUCCESS;
+    
+    unsigned free_columns = 32 - popcount32(sys.pivots);
+    uint64_t solutions = (uint64_t)1 << free_columns;
+    uint32_t zero_seed_state = gamma_seed_state(0);
+    size_t written = 0;
+    
+    for (uint64_t i = 0; i < solutions && written < max_seeds; i++)
+    {
+        uint32_t state = system_solution(&sys, i);
+        
+        if (state == 0)
+            continue;
+        
+        seeds[written++] = state;
+        
+        if (state == zero_seed_state && written < max_seeds)
+            seeds[written++] = 0;
+    }
+    
+    int zero_state = system_satisfied(&sys, 0);
+    int zero_seed = system_satisfied(&sys, zero_seed_state);
+    
+    *seed_count = solutions - (uint64_t)zero_state + (uint64_t)zero_seed;
+    return CRYPTO_SUCCESS;
+}
\ No newline at end of file
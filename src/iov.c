@@ -0,0 +1,109 @@
+#include "iov_internal.h"
+#include <stdint.h>
+
+/**
+ * @brief Sum segment lengths, checking bases
+ * 
+ * @return CRYPTO_ERROR_NULL_POINTER if a non-empty segment has no base,
+ *         CRYPTO_ERROR_INVALID_INPUT if the sum overflows
+ */
+static enum crypto_status iov_length(const struct iovec* segments, size_t count, size_t* total)
+{
+    enum crypto_status status = CRYPTO_SUCCESS;
+    size_t sum = 0;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if (segments[i].iov_len && !segments[i].iov_base)
+            return CRYPTO_ERROR_NULL_POINTER;
+        
+        if (segments[i].iov_len > SIZE_MAX - sum)
+            status = CRYPTO_ERROR_INVALID_INPUT;
+        else
+            sum += segments[i].iov_len;
+    }
+    
+    *total = sum;
+    return status;
+}
+
+/**
+ * @brief Skip exhausted (and empty) segments
+ */
+static void iov_skip_empty(const struct iovec* segments, size_t count, size_t* index, size_t* offset)
+{
+    while (*index < count && *offset == segments[*index].iov_len)
+    {
+        (*index)++;
+        *offset = 0;
+    }
+}
+
+/**
+ * @brief Validate vectors and start cursor at their beginning
+ */
+enum crypto_status iov_cursor_init(
+    struct iov_cursor* cursor,
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    size_t* total
+)
+{
+    size_t input_total;
+    size_t output_total;
+    
+    if ((!input && input_count) || (!output && output_count))
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    enum crypto_status input_status = iov_length(input, input_count, &input_total);
+    enum crypto_status output_status = iov_length(output, output_count, &output_total);
+    
+    if (input_status == CRYPTO_ERROR_NULL_POINTER || output_status == CRYPTO_ERROR_NULL_POINTER)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (input_status != CRYPTO_SUCCESS || output_status != CRYPTO_SUCCESS)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    if (input_total != output_total)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    cursor->input = input;
+    cursor->input_count = input_count;
+    cursor->input_index = 0;
+    cursor->input_offset = 0;
+    cursor->output = output;
+    cursor->output_count = output_count;
+    cursor->output_index = 0;
+    cursor->output_offset = 0;
+    
+    *total = input_total;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Get next run contiguous in both input and output
+ */
+size_t iov_cursor_next(struct iov_cursor* cursor, const unsigned char** in, unsigned char** out)
+{
+    iov_skip_empty(cursor->input, cursor->input_count, &cursor->input_index, &cursor->input_offset);
+    iov_skip_empty(cursor->output, cursor->output_count, &cursor->output_index, &cursor->output_offset);
+    
+    if (cursor->input_index == cursor->input_count || cursor->output_index == cursor->output_count)
+        return 0;
+    
+    const struct iovec* input = &cursor->input[cursor->input_index];
+    const struct iovec* output = &cursor->output[cursor->output_index];
+    
+    size_t run = input->iov_len - cursor->input_offset;
+    if (run > output->iov_len - cursor->output_offset)
+        run = output->iov_len - cursor->output_offset;
+    
+    *in = (const unsigned char*)input->iov_base + cursor->input_offset;
+    *out = (unsigned char*)output->iov_base + cursor->output_offset;
+    
+    cursor->input_offset += run;
+    cursor->output_offset += run;
+    return run;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+ * @file iov_internal.h
+ * @brief Scatter/gather helpers shared between cipher sources
+ * 
+ * Not part of the public API.
+ */
+
+#ifndef CRYPTO_IOV_INTERNAL_H
+#define CRYPTO_IOV_INTERNAL_H
+
+#include "crypto/core.h"
+#include <stddef.h>
+#include <sys/uio.h>
+
+/**
+ * @brief Position in a pair of input and output vectors
+ */
+struct iov_cursor {
+    const struct iovec* input;
+    size_t input_count;
+    size_t input_index;
+    size_t input_offset;
+    const struct iovec* output;
+    size_t output_count;
+    size_t output_index;
+    size_t output_offset;
+};
+
+/**
+ * @brief Validate vectors and start cursor at their beginning
+ * 
+ * @param cursor Cursor to initialize
+ * @param input Input segments
+ * @param input_count Number of input segments
+ * @param output Output segments
+ * @param output_count Number of output segments
+ * @param total Output: total length (equal for input and output)
+ * @return CRYPTO_ERROR_NULL_POINTER for missing arrays or non-empty
+ *         segments without base, CRYPTO_ERROR_INVALID_INPUT if a total
+ *         overflows or totals differ
+ */
+enum crypto_status iov_cursor_init(
+    struct iov_cursor* cursor,
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    size_t* total
+);
+
+/**
+ * @brief Get next run contiguous in both input and output
+ * 
+ * @param cursor Cursor (advanced past the run)
+ * @param in Output: run input
+ * @param out Output: run output
+ * @return Run length, 0 at end
+ */
+size_t iov_cursor_next(struct iov_cursor* cursor, const unsigned char** in, unsigned char** out);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "crypto/letter_index.h"
+#include "letter_parallel_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief "LTRINDEX" in little-endian
+ */
+#define LETTER_INDEX_MAGIC 0x5845444E4952544CULL
+
+/**
+ * @brief Header of index file, followed by count uint64_t entries
+ */
+struct letter_index_header {
+    uint64_t magic;
+    uint64_t stride;
+    uint64_t text_len;
+    uint64_t count;
+};
+
+/**
+ * @brief Build index: one SIMD letter count per stride
+ */
+enum crypto_status letter_index_build(
+    const char* text,
+    size_t text_len,
+    size_t stride,
+    struct letter_index* index
+)
+{
+    if (!text || !index)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (stride == 0)
+        stride = LETTER_INDEX_DEFAULT_STRIDE;
+    
+    size_t count = text_len / stride + 1;
+    if (count > SIZE_MAX / sizeof(uint64_t))
+        return CRYPTO_ERROR_MEMORY;
+    
+    uint64_t* counts = (uint64_t*)malloc(count * sizeof(uint64_t));
+    if (!counts)
+        return CRYPTO_ERROR_MEMORY;
+    
+    uint64_t letters = 0;
+    counts[0] = 0;
+    
+    for (size_t k = 1; k < count; k++)
+    {
+        letters += letter_count(text + (k - 1) * stride, stride);
+        counts[k] = letters;
+    }
+    
+    index->stride = stride;
+    index->text_len = text_len;
+    index->count = count;
+    index->counts = counts;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Letters before offset: nearest entry plus scan of the rest
+ */
+enum crypto_status letter_index_position(
+    const struct letter_index* index,
+    const char* text,
+    size_t offset,
+    size_t* letter_pos
+)
+{
+    if (!index || !index->counts || !text || !letter_pos)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (offset > index->text_len)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    size_t entry = offset / index->stride;
+    size_t start = entry * index->stride;
+    
+    *letter_pos = (size_t)index->counts[entry] + letter_count(text + start, offset - start);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Save index to sidecar file
+ */
+enum crypto_status letter_index_save(const struct letter_index* index, const char* path)
+{
+    if (!index || !index->counts || !path)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    struct letter_index_header header = {
+        LETTER_INDEX_MAGIC, index->stride, index->text_len, index->count
+    };
+    
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(index->counts, sizeof(uint64_t), index->count, file) == index->count;
+    
+    if (fclose(file) != 0)
+        ok = 0;
+    
+    return ok ? CRYPTO_SUCCESS : CRYPTO_ERROR_EXECUTION;
+}
+
+/**
+ * @brief Load index from sidecar file
+ */
+enum crypto_status letter_index_load(const char* path, struct letter_index* index)
+{
+    if (!path || !index)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    struct letter_index_header header;
+    
+    if (fread(&header, sizeof(header), 1, file) != 1)
+    {
+        fclose(file);
+        return CRYPTO_ERROR_INVALID_INPUT;
+    }
+    
+    if (header.magic != LETTER_INDEX_MAGIC || header.stride == 0 || (size_t)header.text_len != header.text_len ||
+        header.count != header.text_len / header.stride + 1 || header.count > SIZE_MAX / sizeof(uint64_t))
+    {
+        fclose(file);
+        return CRYPTO_ERROR_INVALID_INPUT;
+    }
+    
+    uint64_t* counts = (uint64_t*)malloc((size_t)header.count * sizeof(uint64_t));
+    if (!counts)
+    {
+        fclose(file);
+        return CRYPTO_ERROR_MEMORY;
+    }
+    
+    if (fread(counts, sizeof(uint64_t), (size_t)header.count, file) != header.count)
+    {
+        free(counts);
+        fclose(file);
+        return CRYPTO_ERROR_INVALID_INPUT;
+    }
+    
+    fclose(file);
+    
+    index->stride = (size_t)header.stride;
+    index->text_len = (size_t)header.text_len;
+    index->count = (size_t)header.count;
+    index->counts = counts;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Free index
+ */
+void letter_index_free(struct letter_index* index)
+{
+    if (!index)
+        return;
+    
+    free(index->counts);
+    memset(index, 0, sizeof(*index));
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "letter_parallel_internal.h"
+#include "parallel_internal.h"
+#include <stdint.h>
+
+/**
+ * @brief Smallest chunk worth a separate thread (bytes)
+ */
+#define LETTER_MIN_CHUNK (64 * 1024)
+
+/**
+ * @brief Work item of one thread: characters offset .. offset + length - 1
+ */
+struct letter_chunk {
+    const char* in;
+    char* out;
+    size_t offset;
+    size_t length;
+    size_t letters;
+    letter_chunk_fn fn;
+    const void* arg;
+};
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LETTER_X86 1
+#include <immintrin.h>
+
+/**
+ * @brief SIMD letter counters.
+ * 
+ * Letter lanes ((c | 32) - 'a' < 26) are all ones, subtracting them adds
+ * one to per-lane byte counters. Counters are summed with SAD before
+ * they can overflow (255 vectors). Whole vectors only, returns bytes done.
+ */
+__attribute__((target("sse2")))
+static size_t count_sse2(const unsigned char* in, size_t len, size_t* letters)
+{
+    const __m128i case_bit = _mm_set1_epi8(32);
+    const __m128i a = _mm_set1_epi8('a');
+    const __m128i last = _mm_set1_epi8(25);
+    __m128i total = _mm_setzero_si128();
+    size_t i = 0;
+    
+    while (i + 16 <= len)
+    {
+        __m128i counters = _mm_setzero_si128();
+        
+        for (int round = 0; round < 255 && i + 16 <= len; round++, i += 16)
+        {
+            __m128i t = _mm_sub_epi8(_mm_or_si128(_mm_loadu_si128((const __m128i*)(in + i)), case_bit), a);
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_min_epu8(t, last), t));
+        }
+        
+        total = _mm_add_epi64(total, _mm_sad_epu8(counters, _mm_setzero_si128()));
+    }
+    
+    uint64_t sums[2];
+    _mm_storeu_si128((__m128i*)sums, total);
+    *letters += (size_t)(sums[0] + sums[1]);
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t count_avx2(const unsigned char* in, size_t len, size_t* letters)
+{
+    const __m256i case_bit = _mm256_set1_epi8(32);
+    const __m256i a = _mm256_set1_epi8('a');
+    const __m256i last = _mm256_set1_epi8(25);
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    
+    while (i + 32 <= len)
+    {
+        __m256i counters = _mm256_setzero_si256();
+        
+        for (int round = 0; round < 255 && i + 32 <= len; round++, i += 32)
+        {
+            __m256i t = _mm256_sub_epi8(_mm256_or_si256(_mm256_loadu_si256((const __m256i*)(in + i)), case_bit), a);
+            counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(_mm256_min_epu8(t, last), t));
+        }
+        
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counters, _mm256_setzero_si256()));
+    }
+    
+    uint64_t sums[4];
+    _mm256_storeu_si256((__m256i*)sums, total);
+    *letters += (size_t)(sums[0] + sums[1] + sums[2] + sums[3]);
+    return i;
+}
+
+__attribute__((target("avx512bw")))
+static size_t count_avx512(const unsigned char* in, size_t len, size_t* letters)
+{
+    const __m512i case_bit = _mm512_set1_epi8(32);
+    const __m512i a = _mm512_set1_epi8('a');
+    const __m512i twenty_six = _mm512_set1_epi8(26);
+    size_t count = 0;
+    size_t i = 0;
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i t = _mm512_sub_epi8(_mm512_or_si512(_mm512_loadu_si512((const void*)(in + i)), case_bit), a);
+        count += (size_t)__builtin_popcountll((unsigned long long)_mm512_cmplt_epu8_mask(t, twenty_six));
+    }
+    
+    *letters += count;
+    return i;
+}
+#endif
+
+typedef size_t (*count_kernel)(const unsigned char* in, size_t len, size_t* letters);
+
+/**
+ * @brief Picks widest SIMD counter supported by this CPU (NULL if none).
+ */
+static count_kernel select_count_kernel(void)
+{
+#ifdef LETTER_X86
+    if (__builtin_cpu_supports("avx512bw"))
+        return count_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return count_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return count_sse2;
+#endif
+    return NULL;
+}
+
+size_t letter_count(const char* text, size_t len)
+{
+    const unsigned char* in = (const unsigned char*)text;
+    count_kernel kernel = select_count_kernel();
+    size_t letters = 0;
+    size_t i = kernel ? kernel(in, len, &letters) : 0;
+    
+    for (; i < len; i++)
+        letters += (unsigned char)((in[i] | 32) - 'a') < 26;
+    
+    return letters;
+}
+
+/**
+ * @brief Pass one: count letters of the chunk
+ */
+static void* letter_chunk_count(void* arg)
+{
+    struct letter_chunk* chunk = (struct letter_chunk*)arg;
+    
+    chunk->letters = letter_count(chunk->in + chunk->offset, chunk->length);
+    return NULL;
+}
+
+/**
+ * @brief Pass two: transform the chunk from its start position
+ */
+static void* letter_chunk_transform(void* arg)
+{
+    struct letter_chunk* chunk = (struct letter_chunk*)arg;
+    
+    chunk->fn(chunk->in + chunk->offset, chunk->out + chunk->offset, chunk->length, chunk->letters, chunk->arg);
+    return NULL;
+}
+
+/**
+ * @brief Count letters of all chunks, then transform them from their start positions
+ */
+void letter_parallel_run(
+    const char* in,
+    char* out,
+    size_t len,
+    size_t threads,
+    letter_chunk_fn fn,
+    const void* arg
+)
+{
+    struct letter_chunk chunks[PARALLEL_MAX_THREADS];
+    size_t count = parallel_thread_count(len, threads, LETTER_MIN_CHUNK);
+    
+    if (count == 1)
+    {
+        fn(in, out, len, 0, arg);
+        return;
+    }
+    
+    size_t step = (len / count + 63) & ~(size_t)63;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t offset = i * step < len ? i * step : len;
+        size_t end = offset + step < len && i + 1 < count ? offset + step : len;
+        
+        chunks[i] = (struct letter_chunk){ in, out, offset, end - offset, 0, fn, arg };
+    }
+    
+    parallel_run(letter_chunk_count, chunks, sizeof(struct letter_chunk), count);
+    
+    size_t position = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t letters = chunks[i].letters;
+        chunks[i].letters = position;
+        position += letters;
+    }
+    
+    parallel_run(letter_chunk_transform, chunks, sizeof(struct letter_chunk), count);
+}
\ No newline at end of file
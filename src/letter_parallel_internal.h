@@ -0,0 +1,57 @@
+/**
+ * @file letter_parallel_internal.h
+ * @brief Chunk-parallel driver for ciphers keyed by letter position
+ * 
+ * Not part of the public API.
+ */
+
+#ifndef CRYPTO_LETTER_PARALLEL_INTERNAL_H
+#define CRYPTO_LETTER_PARALLEL_INTERNAL_H
+
+#include "crypto/core.h"
+#include <stddef.h>
+
+/**
+ * @brief Transform one chunk whose first letter has position letter_pos
+ * 
+ * @param in Chunk input
+ * @param out Chunk output
+ * @param len Chunk length
+ * @param letter_pos Number of letters before the chunk
+ * @param arg Cipher parameters
+ */
+typedef void (*letter_chunk_fn)(const char* in, char* out, size_t len, size_t letter_pos, const void* arg);
+
+/**
+ * @brief Count letters (A-Z, a-z) of len characters, SIMD when available
+ * 
+ * @param text Characters (no terminator needed)
+ * @param len Number of characters
+ * @return Number of letters
+ */
+size_t letter_count(const char* text, size_t len);
+
+/**
+ * @brief Transform text in chunks on several threads
+ * 
+ * Pass one counts letters of every chunk in parallel, an exclusive
+ * prefix sum of the counts gives the letter position each chunk starts
+ * at, pass two transforms all chunks in parallel.
+ * 
+ * @param in Input characters
+ * @param out Output characters (len bytes)
+ * @param len Text length
+ * @param threads Requested threads (0 = online CPUs)
+ * @param fn Chunk transform
+ * @param arg Passed to fn
+ */
+void letter_parallel_run(
+    const char* in,
+    char* out,
+    size_t len,
+    size_t threads,
+    letter_chunk_fn fn,
+    const void* arg
+);
+
+#endif
\ No newline at end of file
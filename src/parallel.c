@@ -0,0 +1,55 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallel_internal.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * @brief Choose number of threads for given amount of work
+ */
+size_t parallel_thread_count(size_t items, size_t threads, size_t min_per_thread)
+{
+    if (threads == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    
+    size_t max_useful = items / (min_per_thread ? min_per_thread : 1);
+    if (threads > max_useful)
+        threads = max_useful;
+    
+    if (threads > PARALLEL_MAX_THREADS)
+        threads = PARALLEL_MAX_THREADS;
+    
+    return threads ? threads : 1;
+}
+
+/**
+ * @brief Run slices on threads, slice 0 on the calling thread
+ */
+void parallel_run(void* (*run)(void*), void* slices, size_t slice_size, size_t count)
+{
+    pthread_t handles[PARALLEL_MAX_THREADS];
+    int started[PARALLEL_MAX_THREADS];
+    unsigned char* base = (unsigned char*)slices;
+    
+    if (count > PARALLEL_MAX_THREADS)
+        count = PARALLEL_MAX_THREADS;
+    
+    for (size_t i = 1; i < count; i++)
+    {
+        started[i] = pthread_create(&handles[i], NULL, run, base + i * slice_size) == 0;
+        if (!started[i])
+            run(base + i * slice_size);
+    }
+    
+    if (count > 0)
+        run(base);
+    
+    for (size_t i = 1; i < count; i++)
+    {
+        if (started[i])
+            pthread_join(handles[i], NULL);
+    }
+}
\ No newline at end of file
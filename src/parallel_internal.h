@@ -0,0 +1,41 @@
+/**
+ * @file parallel_internal.h
+ * @brief Thread driver shared between multi-threaded functions
+ * 
+ * Not part of the public API.
+ */
+
+#ifndef CRYPTO_PARALLEL_INTERNAL_H
+#define CRYPTO_PARALLEL_INTERNAL_H
+
+#include <stddef.h>
+
+/**
+ * @brief Upper bound of threads (and slice array size) of any driver
+ */
+#define PARALLEL_MAX_THREADS 256
+
+/**
+ * @brief Choose number of threads for given amount of work
+ * 
+ * @param items Work items (bytes, texts, pairs, ...)
+ * @param threads Requested threads (0 = online CPUs)
+ * @param min_per_thread Smallest number of items worth a separate thread
+ * @return Thread count, 1 to PARALLEL_MAX_THREADS
+ */
+size_t parallel_thread_count(size_t items, size_t threads, size_t min_per_thread);
+
+/**
+ * @brief Run one slice per thread and wait for all of them
+ * 
+ * Slice 0 runs on the calling thread. If a thread cannot be created,
+ * its slice runs on the calling thread instead.
+ * 
+ * @param run Slice function, called with a pointer to its slice
+ * @param slices Array of count slices
+ * @param slice_size Size of one slice
+ * @param count Number of slices (1 to PARALLEL_MAX_THREADS)
+ */
+void parallel_run(void* (*run)(void*), void* slices, size_t slice_size, size_t count);
+
+#endif
\ No newline at end of file
@@ -1,113 +1,292 @@
 #include "crypto/polybius.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 /**
- * @brief Get Polybius coordinates for letter
+ * @brief Encode letters of text into digit pairs
  * 
- * @param letter Input letter (A-Z, case insensitive, J→I)
- * @param row Output: row coordinate (1-5)
- * @param col Output: column coordinate (1-5)
- * @return 1 if valid letter, 0 otherwise
+ * Single pass: every byte writes its pair, the output only advances
+ * for letters. Output must have room for 2 * strlen(text) + 1 bytes.
+ * 
+ * @return Number of digits written
  */
-static int letter_to_coords(char letter, int* row, int* col)
+static size_t polybius_encode(const struct polybius_ctx* square, const char* text, char* out)
 {
-    if (((unsigned char)((letter | 32) - 'a')) >= 26)
-        return 0;
-    
-    char upper = letter & ~32;
-    int pos = upper - 'A';
-    
-    if (pos > 8)
-        pos--;
+    char* start = out;
     
-    *row = pos / 5 + 1;
-    *col = pos % 5 + 1;
+    for (const unsigned char* in = (const unsigned char*)text; *in; in++)
+    {
+        const char* pair = square->encode[*in];
+        
+        out[0] = pair[0];
+        out[1] = pair[1];
+        out += pair[0] ? 2 : 0;
+    }
     
-    return 1;
+    return (size_t)(out - start);
 }
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POLYBIUS_X86 1
+#include <immintrin.h>
+
 /**
- * @brief Get letter from Polybius coordinates
+ * @brief SIMD decoders: validate digits, index square, look up letters.
  * 
- * @param row Row coordinate (1-5)
- * @param col Column coordinate (1-5)
- * @return Letter at position, or '\0' if invalid
+ * Digits minus '1' must be 0-4. Multiply-add of each byte pair with
+ * (5, 1) gives the 16-bit square index row * 5 + column, packed to bytes.
+ * Two 16-entry shuffles look up letters: index + 0x70 (saturated) has
+ * the high bit set, which zeroes the lane, exactly for index >= 16, and
+ * index - 16 has it exactly for index < 16.
+ * Stops before the first vector holding an invalid digit (the scalar
+ * loop reports it). Returns digits done (even).
  */
-static char coords_to_letter(int row, int col)
+__attribute__((target("ssse3")))
+static inline __m128i decode_lookup(__m128i index, __m128i low_table, __m128i high_table)
 {
-    unsigned int r = (unsigned int)(row - 1);
-    unsigned int c = (unsigned int)(col - 1);
+    __m128i low = _mm_shuffle_epi8(low_table, _mm_adds_epu8(index, _mm_set1_epi8(0x70)));
+    __m128i high = _mm_shuffle_epi8(high_table, _mm_sub_epi8(index, _mm_set1_epi8(16)));
+    return _mm_or_si128(low, high);
+}
+
+__attribute__((target("ssse3")))
+static size_t decode_ssse3(const struct polybius_ctx* square, const char* in, size_t len, char* out)
+{
+    const __m128i one = _mm_set1_epi8('1');
+    const __m128i four = _mm_set1_epi8(4);
+    const __m128i weights = _mm_set1_epi16(0x0105);
+    const __m128i low_table = _mm_loadu_si128((const __m128i*)square->decode);
+    const __m128i high_table = _mm_loadu_si128((const __m128i*)(square->decode + 16));
+    size_t i = 0;
     
-    if (r >= 5 || c >= 5)
-        return '\0';
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i d = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)(in + i)), one);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, four), d)) != 0xFFFF)
+            break;
+        
+        __m128i index = _mm_maddubs_epi16(d, weights);
+        index = _mm_packus_epi16(index, index);
+        _mm_storel_epi64((__m128i*)(out + i / 2), decode_lookup(index, low_table, high_table));
+    }
     
-    int pos = r * 5 + c;
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t decode_avx2(const struct polybius_ctx* square, const char* in, size_t len, char* out)
+{
+    const __m256i one = _mm256_set1_epi8('1');
+    const __m256i four = _mm256_set1_epi8(4);
+    const __m256i weights = _mm256_set1_epi16(0x0105);
+    const __m128i low_table = _mm_loadu_si128((const __m128i*)square->decode);
+    const __m128i high_table = _mm_loadu_si128((const __m128i*)(square->decode + 16));
+    size_t i = 0;
     
-    if (pos > 8)
-        pos++;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i d = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i*)(in + i)), one);
+        if ((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(d, four), d)) != 0xFFFFFFFFu)
+            break;
+        
+        __m256i wide = _mm256_maddubs_epi16(d, weights);
+        wide = _mm256_permute4x64_epi64(_mm256_packus_epi16(wide, wide), _MM_SHUFFLE(3, 1, 2, 0));
+        
+        __m128i index = _mm256_castsi256_si128(wide);
+        _mm_storeu_si128((__m128i*)(out + i / 2), decode_lookup(index, low_table, high_table));
+    }
+    
+    return i;
+}
+
+__attribute__((target("avx512bw")))
+static size_t decode_avx512(const struct polybius_ctx* square, const char* in, size_t len, char* out)
+{
+    const __m512i one = _mm512_set1_epi8('1');
+    const __m512i five = _mm512_set1_epi8(5);
+    const __m512i weights = _mm512_set1_epi16(0x0105);
+    const __m512i order = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+    const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)square->decode));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(square->decode + 16)));
+    size_t i = 0;
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i d = _mm512_sub_epi8(_mm512_loadu_si512((const void*)(in + i)), one);
+        if (_mm512_cmpge_epu8_mask(d, five) != 0)
+            break;
+        
+        __m512i wide = _mm512_maddubs_epi16(d, weights);
+        wide = _mm512_permutexvar_epi64(order, _mm512_packus_epi16(wide, wide));
+        
+        __m256i index = _mm512_castsi512_si256(wide);
+        __m256i low = _mm256_shuffle_epi8(low_table, _mm256_adds_epu8(index, _mm256_set1_epi8(0x70)));
+        __m256i high = _mm256_shuffle_epi8(high_table, _mm256_sub_epi8(index, _mm256_set1_epi8(16)));
+        _mm256_storeu_si256((__m256i*)(out + i / 2), _mm256_or_si256(low, high));
+    }
     
-    return 'A' + pos;
+    return i;
 }
+#endif
+
+typedef size_t (*polybius_kernel)(const struct polybius_ctx* square, const char* in, size_t len, char* out);
 
 /**
- * @brief Encrypt plaintext using Polybius square
+ * @brief Picks widest SIMD decoder supported by this CPU (NULL if none)
+ */
+static polybius_kernel select_kernel(void)
+{
+#ifdef POLYBIUS_X86
+    if (__builtin_cpu_supports("avx512bw"))
+        return decode_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return decode_avx2;
+    if (__builtin_cpu_supports("ssse3"))
+        return decode_ssse3;
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Decode digit pairs into letters
  * 
- * Each letter becomes 2 digits (row, column).
- * Non-letters are ignored. Output is always digits.
+ * @param square Square tables
+ * @param in Digits (even length)
+ * @param len Number of digits
+ * @param out Output: len / 2 letters
+ * @return 0 on success, -1 if a digit is not 1-5
+ */
+static int polybius_decode(const struct polybius_ctx* square, const char* in, size_t len, char* out)
+{
+    polybius_kernel kernel = select_kernel();
+    size_t i = kernel ? kernel(square, in, len, out) : 0;
+    
+    for (; i < len; i += 2)
+    {
+        unsigned int row = (unsigned int)(unsigned char)in[i] - '1';
+        unsigned int col = (unsigned int)(unsigned char)in[i + 1] - '1';
+        
+        if (row >= 5 || col >= 5)
+            return -1;
+        
+        out[i / 2] = square->decode[row * 5 + col];
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Build keyed square tables
  * 
- * @param plaintext Input text
- * @param ciphertext Output pointer (caller must free)
- * @return Status code
+ * Layout is keyword letters then the rest of the alphabet (I/J merged);
+ * every byte of the encode table is derived from it once.
  */
-enum crypto_status encrypt_polybius(const char* plaintext, char** ciphertext)
+enum crypto_status polybius_ctx_init(struct polybius_ctx* ctx, const char* keyword)
 {
-    if (!plaintext || !ciphertext)
+    if (!ctx)
         return CRYPTO_ERROR_NULL_POINTER;
     
-    size_t letter_count = 0;
-    for (size_t i = 0; plaintext[i]; i++)
+    if (!keyword)
+        keyword = "";
+    
+    for (size_t i = 0; keyword[i]; i++)
     {
-        int row, col;
-        if (letter_to_coords(plaintext[i], &row, &col))
-            letter_count++;
+        if (((unsigned char)((keyword[i] | 32) - 'a')) >= 26)
+            return CRYPTO_ERROR_INVALID_KEY;
     }
     
-    size_t output_size = letter_count * 2 + 1;
-    char* result = (char*)malloc(output_size);
-    if (!result)
-        return CRYPTO_ERROR_MEMORY;
+    const char* alphabet = "ABCDEFGHIKLMNOPQRSTUVWXYZ";
+    int square_pos[26];
+    int used = 0;
+    
+    for (int j = 0; j < 26; j++)
+        square_pos[j] = -1;
+    
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const char* source = pass == 0 ? keyword : alphabet;
+        
+        for (size_t i = 0; source[i]; i++)
+        {
+            int letter = (source[i] & ~32) - 'A';
+            if (letter == 'J' - 'A')
+                letter = 'I' - 'A';
+            
+            if (square_pos[letter] >= 0)
+                continue;
+            
+            square_pos[letter] = used;
+            ctx->decode[used] = (char)('A' + letter);
+            used++;
+        }
+    }
+    
+    square_pos['J' - 'A'] = square_pos['I' - 'A'];
+    memset(ctx->decode + 25, 0, sizeof(ctx->decode) - 25);
     
-    size_t pos = 0;
-    for (size_t i = 0; plaintext[i]; i++)
+    for (int c = 0; c < 256; c++)
     {
-        int row, col;
-        if (letter_to_coords(plaintext[i], &row, &col))
+        unsigned int letter = (unsigned char)((c | 32) - 'a');
+        
+        if (letter >= 26)
         {
-            result[pos++] = '0' + row;
-            result[pos++] = '0' + col;
+            ctx->encode[c][0] = 0;
+            ctx->encode[c][1] = 0;
+            continue;
         }
+        
+        ctx->encode[c][0] = (char)('1' + square_pos[letter] / 5);
+        ctx->encode[c][1] = (char)('1' + square_pos[letter] % 5);
     }
     
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt plaintext with prepared square
+ * 
+ * Each letter becomes 2 digits (row, column).
+ * Non-letters are ignored. Output is always digits.
+ */
+enum crypto_status encrypt_polybius_ctx(const struct polybius_ctx* ctx, const char* plaintext, char** ciphertext)
+{
+    if (!ctx || !plaintext || !ciphertext)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    size_t len = strlen(plaintext);
+    if (len > (SIZE_MAX - 1) / 2)
+        return CRYPTO_ERROR_MEMORY;
+    
+    char* result = (char*)malloc(len * 2 + 1);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    size_t pos = polybius_encode(ctx, plaintext, result);
     result[pos] = '\0';
+    
+    /* Give back the room reserved for non-letters */
+    if (pos < len)
+    {
+        char* shrunk = (char*)realloc(result, pos + 1);
+        if (shrunk)
+            result = shrunk;
+    }
+    
     *ciphertext = result;
     return CRYPTO_SUCCESS;
 }
 
 /**
- * @brief Decrypt ciphertext using Polybius square
+ * @brief Decrypt ciphertext with prepared square
  * 
  * Pairs of digits become letters.
  * Input must have even length and contain only digits 1-5.
  * Output is always uppercase (case information lost).
- * 
- * @param ciphertext Input digits (pairs of 1-5)
- * @param plaintext Output pointer (caller must free)
- * @return Status code
  */
-enum crypto_status decrypt_polybius(const char* ciphertext, char** plaintext)
+enum crypto_status decrypt_polybius_ctx(const struct polybius_ctx* ctx, const char* ciphertext, char** plaintext)
 {
-    if (!ciphertext || !plaintext)
+    if (!ctx || !ciphertext || !plaintext)
         return CRYPTO_ERROR_NULL_POINTER;
     
     size_t len = strlen(ciphertext);
@@ -115,35 +294,54 @@ enum crypto_status decrypt_polybius(const char* ciphertext, char** plaintext)
     if (len % 2 != 0)
         return CRYPTO_ERROR_INVALID_INPUT;
     
-    size_t output_size = len / 2 + 1;
-    char* result = (char*)malloc(output_size);
+    char* result = (char*)malloc(len / 2 + 1);
     if (!result)
         return CRYPTO_ERROR_MEMORY;
     
-    size_t pos = 0;
-    for (size_t i = 0; i < len; i += 2)
+    if (polybius_decode(ctx, ciphertext, len, result) != 0)
     {
-        if (ciphertext[i] < '1' || ciphertext[i] > '5' ||
-            ciphertext[i+1] < '1' || ciphertext[i+1] > '5')
-        {
-            free(result);
-            return CRYPTO_ERROR_INVALID_INPUT;
-        }
-        
-        int row = ciphertext[i] - '0';
-        int col = ciphertext[i+1] - '0';
-        
-        char letter = coords_to_letter(row, col);
-        if (letter == '\0')
-        {
-            free(result);
-            return CRYPTO_ERROR_INVALID_INPUT;
-        }
-        
-        result[pos++] = letter;
+        free(result);
+        return CRYPTO_ERROR_INVALID_INPUT;
     }
     
-    result[pos] = '\0';
+    result[len / 2] = '\0';
     *plaintext = result;
     return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt plaintext using Polybius square
+ * 
+ * Each letter becomes 2 digits (row, column).
+ * Non-letters are ignored. Output is always digits.
+ * 
+ * @param plaintext Input text
+ * @param ciphertext Output pointer (caller must free)
+ * @return Status code
+ */
+enum crypto_status encrypt_polybius(const char* plaintext, char** ciphertext)
+{
+    struct polybius_ctx square;
+    polybius_ctx_init(&square, NULL);
+    
+    return encrypt_polybius_ctx(&square, plaintext, ciphertext);
+}
+
+/**
+ * @brief Decrypt ciphertext using Polybius square
+ * 
+ * Pairs of digits become letters.
+ * Input must have even length and contain only digits 1-5.
+ * Output is always uppercase (case information lost).
+ * 
+ * @param ciphertext Input digits (pairs of 1-5)
+ * @param plaintext Output pointer (caller must free)
+ * @return Status code
+ */
+enum crypto_status decrypt_polybius(const char* ciphertext, char** plaintext)
+{
+    struct polybius_ctx square;
+    polybius_ctx_init(&square, NULL);
+    
+    return decrypt_polybius_ctx(&square, ciphertext, plaintext);
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "crypto/trithemius.h"
+#include "iov_internal.h"
+#include "letter_parallel_internal.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -36,6 +38,229 @@ static char shift_char(char c, int key)
     return (c - base + key) % 26 + base;
 }
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRITHEMIUS_X86 1
+#include <immintrin.h>
+
+/**
+ * @brief SIMD kernels: letter positions from in-register prefix counts.
+ * 
+ * Letter lanes are found as in Caesar ((c | 32) - 'a' < 26). A log-step
+ * prefix sum of the letter mask gives each lane the number of letters
+ * before it in the vector; adding the phase (letter position mod 26) of
+ * the vector start yields each letter's own phase. The shift repeats with
+ * period 26, so all values stay in bytes, reduced mod 26 by min(x, x - 26).
+ * 
+ * Encryption shifts by base + phase, decryption by base - phase
+ * (base = key mod 26, or 26 + (-key mod 26) when decrypting).
+ * Processes whole vectors only, returns bytes done.
+ */
+__attribute__((target("sse2")))
+static inline __m128i mod26_sse2(__m128i x)
+{
+    return _mm_min_epu8(x, _mm_sub_epi8(x, _mm_set1_epi8(26)));
+}
+
+__attribute__((target("sse2")))
+static size_t trithemius_sse2(const unsigned char* in, unsigned char* out, size_t len,
+    int base, size_t* letter_pos, int direction)
+{
+    const __m128i case_bit = _mm_set1_epi8(32);
+    const __m128i a = _mm_set1_epi8('a');
+    const __m128i last = _mm_set1_epi8(25);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i key = _mm_set1_epi8((char)base);
+    size_t pos = *letter_pos;
+    size_t i = 0;
+    
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i c = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i t = _mm_sub_epi8(_mm_or_si128(c, case_bit), a);
+        __m128i letter = _mm_cmpeq_epi8(_mm_min_epu8(t, last), t);
+        __m128i count = _mm_and_si128(letter, one);
+        
+        __m128i prefix = _mm_add_epi8(count, _mm_slli_si128(count, 1));
+        prefix = _mm_add_epi8(prefix, _mm_slli_si128(prefix, 2));
+        prefix = _mm_add_epi8(prefix, _mm_slli_si128(prefix, 4));
+        prefix = _mm_add_epi8(prefix, _mm_slli_si128(prefix, 8));
+        
+        __m128i phase = _mm_add_epi8(_mm_sub_epi8(prefix, count), _mm_set1_epi8((char)(pos % 26)));
+        phase = mod26_sse2(phase);
+        
+        __m128i shift = direction > 0 ? _mm_add_epi8(key, phase) : _mm_sub_epi8(key, phase);
+        __m128i shifted = mod26_sse2(_mm_add_epi8(t, mod26_sse2(shift)));
+        __m128i delta = _mm_and_si128(letter, _mm_sub_epi8(shifted, t));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_add_epi8(c, delta));
+        
+        pos += (size_t)__builtin_popcount((unsigned)_mm_movemask_epi8(letter));
+    }
+    
+    *letter_pos = pos;
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i mod26_avx2(__m256i x)
+{
+    return _mm256_min_epu8(x, _mm256_sub_epi8(x, _mm256_set1_epi8(26)));
+}
+
+__attribute__((target("avx2")))
+static size_t trithemius_avx2(const unsigned char* in, unsigned char* out, size_t len,
+    int base, size_t* letter_pos, int direction)
+{
+    const __m256i case_bit = _mm256_set1_epi8(32);
+    const __m256i a = _mm256_set1_epi8('a');
+    const __m256i last = _mm256_set1_epi8(25);
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i top = _mm256_set1_epi8(15);
+    const __m256i key = _mm256_set1_epi8((char)base);
+    size_t pos = *letter_pos;
+    size_t i = 0;
+    
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i t = _mm256_sub_epi8(_mm256_or_si256(c, case_bit), a);
+        __m256i letter = _mm256_cmpeq_epi8(_mm256_min_epu8(t, last), t);
+        __m256i count = _mm256_and_si256(letter, one);
+        
+        __m256i prefix = _mm256_add_epi8(count, _mm256_slli_si256(count, 1));
+        prefix = _mm256_add_epi8(prefix, _mm256_slli_si256(prefix, 2));
+        prefix = _mm256_add_epi8(prefix, _mm256_slli_si256(prefix, 4));
+        prefix = _mm256_add_epi8(prefix, _mm256_slli_si256(prefix, 8));
+        
+        /* Byte shifts stay within 128-bit lanes: carry low lane total into high lane */
+        __m256i carry = _mm256_shuffle_epi8(_mm256_permute2x128_si256(prefix, prefix, 0x08), top);
+        prefix = _mm256_add_epi8(prefix, carry);
+        
+        __m256i phase = _mm256_add_epi8(_mm256_sub_epi8(prefix, count), _mm256_set1_epi8((char)(pos % 26)));
+        phase = mod26_avx2(mod26_avx2(phase));
+        
+        __m256i shift = direction > 0 ? _mm256_add_epi8(key, phase) : _mm256_sub_epi8(key, phase);
+        __m256i shifted = mod26_avx2(_mm256_add_epi8(t, mod26_avx2(shift)));
+        __m256i delta = _mm256_and_si256(letter, _mm256_sub_epi8(shifted, t));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_add_epi8(c, delta));
+        
+        pos += (size_t)__builtin_popcount((unsigned)_mm256_movemask_epi8(letter));
+    }
+    
+    *letter_pos = pos;
+    return i;
+}
+
+__attribute__((target("avx512bw")))
+static inline __m512i mod26_avx512(__m512i x)
+{
+    return _mm512_min_epu8(x, _mm512_sub_epi8(x, _mm512_set1_epi8(26)));
+}
+
+__attribute__((target("avx512bw")))
+static size_t trithemius_avx512(const unsigned char* in, unsigned char* out, size_t len,
+    int base, size_t* letter_pos, int direction)
+{
+    const __m512i case_bit = _mm512_set1_epi8(32);
+    const __m512i a = _mm512_set1_epi8('a');
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i top = _mm512_set1_epi8(15);
+    const __m512i key = _mm512_set1_epi8((char)base);
+    size_t pos = *letter_pos;
+    size_t i = 0;
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i c = _mm512_loadu_si512((const void*)(in + i));
+        __m512i t = _mm512_sub_epi8(_mm512_or_si512(c, case_bit), a);
+        __mmask64 letter = _mm512_cmplt_epu8_mask(t, _mm512_set1_epi8(26));
+        __m512i count = _mm512_maskz_mov_epi8(letter, one);
+        
+        __m512i prefix = _mm512_add_epi8(count, _mm512_bslli_epi128(count, 1));
+        prefix = _mm512_add_epi8(prefix, _mm512_bslli_epi128(prefix, 2));
+        prefix = _mm512_add_epi8(prefix, _mm512_bslli_epi128(prefix, 4));
+        prefix = _mm512_add_epi8(prefix, _mm512_bslli_epi128(prefix, 8));
+        
+        /* Exclusive scan of the four 128-bit lane totals */
+        __m512i totals = _mm512_shuffle_epi8(prefix, top);
+        __m512i before = _mm512_maskz_shuffle_i64x2(0xFC, totals, totals, _MM_SHUFFLE(2, 1, 0, 0));
+        __m512i carry = _mm512_add_epi8(before, _mm512_maskz_shuffle_i64x2(0xFC, before, before, _MM_SHUFFLE(2, 1, 0, 0)));
+        carry = _mm512_add_epi8(carry, _mm512_maskz_shuffle_i64x2(0xF0, before, before, _MM_SHUFFLE(1, 0, 0, 0)));
+        prefix = _mm512_add_epi8(prefix, carry);
+        
+        __m512i phase = _mm512_add_epi8(_mm512_sub_epi8(prefix, count), _mm512_set1_epi8((char)(pos % 26)));
+        phase = mod26_avx512(mod26_avx512(mod26_avx512(phase)));
+        
+        __m512i shift = direction > 0 ? _mm512_add_epi8(key, phase) : _mm512_sub_epi8(key, phase);
+        __m512i shifted = mod26_avx512(_mm512_add_epi8(t, mod26_avx512(shift)));
+        __m512i r = _mm512_mask_add_epi8(c, letter, c, _mm512_sub_epi8(shifted, t));
+        _mm512_storeu_si512((void*)(out + i), r);
+        
+        pos += (size_t)__builtin_popcountll((unsigned long long)letter);
+    }
+    
+    *letter_pos = pos;
+    return i;
+}
+#endif
+
+typedef size_t (*trithemius_kernel)(const unsigned char* in, unsigned char* out, size_t len,
+    int base, size_t* letter_pos, int direction);
+
+/**
+ * @brief Picks widest SIMD kernel supported by this CPU (NULL if none).
+ */
+static trithemius_kernel select_kernel(void)
+{
+#ifdef TRITHEMIUS_X86
+    if (__builtin_cpu_supports("avx512bw"))
+        return trithemius_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return trithemius_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return trithemius_sse2;
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Shifts letters of len characters by (key + letter position).
+ * 
+ * @param in Input characters
+ * @param out Output characters (may equal in)
+ * @param len Number of characters
+ * @param key Initial shift amount
+ * @param letter_pos Letter position of first letter (advanced past run)
+ * @param direction 1 to encrypt, -1 to decrypt
+ */
+static void trithemius_run(const char* in, char* out, size_t len, int key, size_t* letter_pos, int direction)
+{
+    trithemius_kernel kernel = select_kernel();
+    int base = ((key % 26) + 26) % 26;
+    size_t done = 0;
+    
+    if (direction < 0)
+        base = 26 + (26 - base) % 26;
+    
+    if (kernel)
+        done = kernel((const unsigned char*)in, (unsigned char*)out, len, base, letter_pos, direction);
+    
+    size_t pos = *letter_pos;
+    
+    for (size_t i = done; i < len; i++)
+    {
+        if (is_letter(in[i]))
+        {
+            int shift = key % 26 + (int)(pos % 26);
+            out[i] = shift_char(in[i], direction * shift);
+            pos++;
+        }
+        else
+            out[i] = in[i];
+    }
+    
+    *letter_pos = pos;
+}
+
 /**
  * @brief Encrypt plaintext using Trithemius cipher.
  * 
@@ -58,17 +283,7 @@ enum crypto_status encrypt_trithemius(const char* plaintext, int key, char** cip
         return CRYPTO_ERROR_MEMORY;
     
     size_t letter_pos = 0;
-    
-    for (size_t i = 0; i < len; i++)
-    {
-        if (is_letter(plaintext[i]))
-        {
-            result[i] = shift_char(plaintext[i], key + letter_pos);
-            letter_pos++;
-        }
-        else
-            result[i] = plaintext[i];
-    }
+    trithemius_run(plaintext, result, len, key, &letter_pos, 1);
     
     result[len] = '\0';
     *ciphertext = result;
@@ -97,19 +312,211 @@ enum crypto_status decrypt_trithemius(const char* ciphertext, int key, char** pl
         return CRYPTO_ERROR_MEMORY;
     
     size_t letter_pos = 0;
+    trithemius_run(ciphertext, result, len, key, &letter_pos, -1);
+    
+    result[len] = '\0';
+    *plaintext = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Applies Trithemius shifts over scatter/gather vectors.
+ * 
+ * Letter position carries over segment boundaries.
+ */
+static enum crypto_status trithemius_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key,
+    int direction
+)
+{
+    struct iov_cursor cursor;
+    size_t total;
+    size_t letter_pos = 0;
+    const unsigned char* in;
+    unsigned char* out;
+    size_t run;
+    
+    enum crypto_status status = iov_cursor_init(&cursor, input, input_count, output, output_count, &total);
+    if (status != CRYPTO_SUCCESS)
+        return status;
     
-    for (size_t i = 0; i < len; i++)
+    while ((run = iov_cursor_next(&cursor, &in, &out)) > 0)
+        trithemius_run((const char*)in, (char*)out, run, key, &letter_pos, direction);
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt scatter/gather buffers using Trithemius cipher.
+ */
+enum crypto_status encrypt_trithemius_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+)
+{
+    return trithemius_iov(input, input_count, output, output_count, key, 1);
+}
+
+/**
+ * @brief Decrypt scatter/gather buffers using Trithemius cipher.
+ */
+enum crypto_status decrypt_trithemius_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    int key
+)
+{
+    return trithemius_iov(input, input_count, output, output_count, key, -1);
+}
+
+/**
+ * @brief Start streaming Trithemius transformation.
+ */
+enum crypto_status trithemius_stream_init(
+    struct trithemius_stream_ctx* ctx,
+    int key,
+    int decrypt,
+    size_t letter_offset
+)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    ctx->key = key;
+    ctx->direction = decrypt ? -1 : 1;
+    ctx->letter_pos = letter_offset;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Transform next chunk; letter position carries over chunks.
+ */
+enum crypto_status trithemius_stream_update(
+    struct trithemius_stream_ctx* ctx,
+    const char* input,
+    size_t input_len,
+    char* output
+)
+{
+    if (!ctx || !input || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    trithemius_run(input, output, input_len, ctx->key, &ctx->letter_pos, ctx->direction);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Finish streaming Trithemius transformation.
+ */
+enum crypto_status trithemius_stream_final(struct trithemius_stream_ctx* ctx)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    memset(ctx, 0, sizeof(*ctx));
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Decrypt byte range of Trithemius ciphertext.
+ */
+enum crypto_status decrypt_trithemius_range(
+    const char* ciphertext,
+    size_t ciphertext_len,
+    const struct letter_index* index,
+    int key,
+    size_t offset,
+    size_t length,
+    char** plaintext
+)
+{
+    if (!ciphertext || !plaintext)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (length == 0 || offset > ciphertext_len || length > ciphertext_len - offset)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    size_t letter_pos;
+    
+    if (index)
     {
-        if (is_letter(ciphertext[i]))
-        {
-            result[i] = shift_char(ciphertext[i], -(key + letter_pos));
-            letter_pos++;
-        }
-        else
-            result[i] = ciphertext[i];
+        if (index->text_len != ciphertext_len)
+            return CRYPTO_ERROR_INVALID_INPUT;
+        
+        enum crypto_status status = letter_index_position(index, ciphertext, offset, &letter_pos);
+        if (status != CRYPTO_SUCCESS)
+            return status;
     }
+    else
+        letter_pos = letter_count(ciphertext, offset);
     
-    result[len] = '\0';
+    char* result = (char*)malloc(length + 1);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    trithemius_run(ciphertext + offset, result, length, key, &letter_pos, -1);
+    
+    result[length] = '\0';
     *plaintext = result;
     return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Trithemius parameters of parallel chunks.
+ */
+struct trithemius_params {
+    int key;
+    int direction;
+};
+
+static void trithemius_chunk(const char* in, char* out, size_t len, size_t letter_pos, const void* arg)
+{
+    const struct trithemius_params* params = (const struct trithemius_params*)arg;
+    trithemius_run(in, out, len, params->key, &letter_pos, params->direction);
+}
+
+/**
+ * @brief Applies Trithemius shifts on several threads.
+ */
+static enum crypto_status trithemius_parallel(const char* input, int key, size_t threads, int direction, char** output)
+{
+    if (!input || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    size_t len = strlen(input);
+    char* result = (char*)malloc(len + 1);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    struct trithemius_params params = { key, direction };
+    letter_parallel_run(input, result, len, threads, trithemius_chunk, &params);
+    
+    result[len] = '\0';
+    *output = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt plaintext using Trithemius cipher on several threads.
+ */
+enum crypto_status encrypt_trithemius_parallel(const char* plaintext, int key, size_t threads, char** ciphertext)
+{
+    return trithemius_parallel(plaintext, key, threads, 1, ciphertext);
+}
+
+/**
+ * @brief Decrypt ciphertext using Trithemius cipher on several threads.
+ */
+enum crypto_status decrypt_trithemius_parallel(const char* ciphertext, int key, size_t threads, char** plaintext)
+{
+    return trithemius_parallel(ciphertext, key, threads, -1, plaintext);
 }
\ No newline at end of file
@@ -1,7 +1,307 @@
 #include "crypto/vernam.h"
+#include "iov_internal.h"
+#include "vernam_internal.h"
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VERNAM_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Default size from which output bypasses the cache (8 MiB)
+ */
+#define VERNAM_STREAM_THRESHOLD_DEFAULT ((size_t)8 * 1024 * 1024)
+
+/**
+ * @brief Bytes read ahead by software prefetch in streaming kernels
+ */
+#define VERNAM_PREFETCH_DISTANCE 1024
+
+static _Atomic size_t stream_threshold = VERNAM_STREAM_THRESHOLD_DEFAULT;
+
+/**
+ * @brief XOR kernel: out[i] = data[i] ^ key[i]
+ */
+typedef void (*vernam_kernel)(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len);
+
+/**
+ * @brief Portable XOR kernel, 8 bytes per step
+ */
+static void xor_scalar(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = 0;
+    
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t a, b;
+        memcpy(&a, data + i, 8);
+        memcpy(&b, key + i, 8);
+        a ^= b;
+        memcpy(out + i, &a, 8);
+    }
+    
+    for (; i < len; i++)
+        out[i] = data[i] ^ key[i];
+}
+
+#ifdef VERNAM_X86
+__attribute__((target("sse2")))
+static void xor_sse2(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = 0;
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        __m128i a2 = _mm_loadu_si128((const __m128i*)(data + i + 32));
+        __m128i a3 = _mm_loadu_si128((const __m128i*)(data + i + 48));
+        
+        a0 = _mm_xor_si128(a0, _mm_loadu_si128((const __m128i*)(key + i)));
+        a1 = _mm_xor_si128(a1, _mm_loadu_si128((const __m128i*)(key + i + 16)));
+        a2 = _mm_xor_si128(a2, _mm_loadu_si128((const __m128i*)(key + i + 32)));
+        a3 = _mm_xor_si128(a3, _mm_loadu_si128((const __m128i*)(key + i + 48)));
+        
+        _mm_storeu_si128((__m128i*)(out + i), a0);
+        _mm_storeu_si128((__m128i*)(out + i + 16), a1);
+        _mm_storeu_si128((__m128i*)(out + i + 32), a2);
+        _mm_storeu_si128((__m128i*)(out + i + 48), a3);
+    }
+    
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(data + i));
+        a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i*)(key + i)));
+        _mm_storeu_si128((__m128i*)(out + i), a);
+    }
+    
+    xor_scalar(data + i, key + i, out + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static void xor_avx2(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = 0;
+    
+    for (; i + 128 <= len; i += 128)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(data + i + 32));
+        __m256i a2 = _mm256_loadu_si256((const __m256i*)(data + i + 64));
+        __m256i a3 = _mm256_loadu_si256((const __m256i*)(data + i + 96));
+        
+        a0 = _mm256_xor_si256(a0, _mm256_loadu_si256((const __m256i*)(key + i)));
+        a1 = _mm256_xor_si256(a1, _mm256_loadu_si256((const __m256i*)(key + i + 32)));
+        a2 = _mm256_xor_si256(a2, _mm256_loadu_si256((const __m256i*)(key + i + 64)));
+        a3 = _mm256_xor_si256(a3, _mm256_loadu_si256((const __m256i*)(key + i + 96)));
+        
+        _mm256_storeu_si256((__m256i*)(out + i), a0);
+        _mm256_storeu_si256((__m256i*)(out + i + 32), a1);
+        _mm256_storeu_si256((__m256i*)(out + i + 64), a2);
+        _mm256_storeu_si256((__m256i*)(out + i + 96), a3);
+    }
+    
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(data + i));
+        a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i*)(key + i)));
+        _mm256_storeu_si256((__m256i*)(out + i), a);
+    }
+    
+    xor_scalar(data + i, key + i, out + i, len - i);
+}
+
+__attribute__((target("avx512f")))
+static void xor_avx512(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = 0;
+    
+    for (; i + 256 <= len; i += 256)
+    {
+        __m512i a0 = _mm512_loadu_si512((const void*)(data + i));
+        __m512i a1 = _mm512_loadu_si512((const void*)(data + i + 64));
+        __m512i a2 = _mm512_loadu_si512((const void*)(data + i + 128));
+        __m512i a3 = _mm512_loadu_si512((const void*)(data + i + 192));
+        
+        a0 = _mm512_xor_si512(a0, _mm512_loadu_si512((const void*)(key + i)));
+        a1 = _mm512_xor_si512(a1, _mm512_loadu_si512((const void*)(key + i + 64)));
+        a2 = _mm512_xor_si512(a2, _mm512_loadu_si512((const void*)(key + i + 128)));
+        a3 = _mm512_xor_si512(a3, _mm512_loadu_si512((const void*)(key + i + 192)));
+        
+        _mm512_storeu_si512((void*)(out + i), a0);
+        _mm512_storeu_si512((void*)(out + i + 64), a1);
+        _mm512_storeu_si512((void*)(out + i + 128), a2);
+        _mm512_storeu_si512((void*)(out + i + 192), a3);
+    }
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        __m512i a = _mm512_loadu_si512((const void*)(data + i));
+        a = _mm512_xor_si512(a, _mm512_loadu_si512((const void*)(key + i)));
+        _mm512_storeu_si512((void*)(out + i), a);
+    }
+    
+    xor_scalar(data + i, key + i, out + i, len - i);
+}
+
+/**
+ * @brief XOR bytes until out is 64-byte aligned
+ * 
+ * @return Bytes processed
+ */
+static size_t xor_align_head(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t head = (size_t)(-(uintptr_t)out & 63);
+    
+    if (head > len)
+        head = len;
+    
+    xor_scalar(data, key, out, head);
+    return head;
+}
+
+/**
+ * @brief Streaming kernels: non-temporal stores, prefetched loads
+ * 
+ * Output goes to memory through write-combining buffers instead of
+ * being pulled into cache (no read-for-ownership, no eviction of other
+ * data). Followed by sfence so stores are ordered before returning.
+ */
+__attribute__((target("sse2")))
+static void xor_sse2_stream(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = xor_align_head(data, key, out, len);
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        _mm_prefetch((const char*)(data + i + VERNAM_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        _mm_prefetch((const char*)(key + i + VERNAM_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        
+        for (size_t j = 0; j < 64; j += 16)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(data + i + j));
+            a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i*)(key + i + j)));
+            _mm_stream_si128((__m128i*)(out + i + j), a);
+        }
+    }
+    
+    _mm_sfence();
+    xor_scalar(data + i, key + i, out + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static void xor_avx2_stream(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = xor_align_head(data, key, out, len);
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        _mm_prefetch((const char*)(data + i + VERNAM_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        _mm_prefetch((const char*)(key + i + VERNAM_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(data + i + 32));
+        
+        a0 = _mm256_xor_si256(a0, _mm256_loadu_si256((const __m256i*)(key + i)));
+        a1 = _mm256_xor_si256(a1, _mm256_loadu_si256((const __m256i*)(key + i + 32)));
+        
+        _mm256_stream_si256((__m256i*)(out + i), a0);
+        _mm256_stream_si256((__m256i*)(out + i + 32), a1);
+    }
+    
+    _mm_sfence();
+    xor_scalar(data + i, key + i, out + i, len - i);
+}
+
+__attribute__((target("avx512f")))
+static void xor_avx512_stream(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len)
+{
+    size_t i = xor_align_head(data, key, out, len);
+    
+    for (; i + 64 <= len; i += 64)
+    {
+        _mm_prefetch((const char*)(data + i + VERNAM_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        _mm_prefetch((const char*)(key + i + VERNAM_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        
+        __m512i a = _mm512_loadu_si512((const void*)(data + i));
+        a = _mm512_xor_si512(a, _mm512_loadu_si512((const void*)(key + i)));
+        _mm512_stream_si512((void*)(out + i), a);
+    }
+    
+    _mm_sfence();
+    xor_scalar(data + i, key + i, out + i, len - i);
+}
+#endif
+
+/**
+ * @brief Pick widest XOR kernel supported by this CPU
+ * 
+ * @param stream Nonzero to use non-temporal stores
+ */
+static vernam_kernel select_kernel(int stream)
+{
+#ifdef VERNAM_X86
+    if (__builtin_cpu_supports("avx512f"))
+        return stream ? xor_avx512_stream : xor_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return stream ? xor_avx2_stream : xor_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return stream ? xor_sse2_stream : xor_sse2;
+#else
+    (void)stream;
+#endif
+    return xor_scalar;
+}
+
+/**
+ * @brief XOR with kernel picked for given streaming decision
+ */
+void vernam_xor_kernel(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len, int stream)
+{
+    select_kernel(stream)(data, key, out, len);
+}
+
+/**
+ * @brief Set size from which vernam_xor uses non-temporal stores
+ */
+void vernam_set_stream_threshold(size_t bytes)
+{
+    atomic_store_explicit(&stream_threshold, bytes, memory_order_relaxed);
+}
+
+/**
+ * @brief Get size from which vernam_xor uses non-temporal stores
+ */
+size_t vernam_get_stream_threshold(void)
+{
+    return atomic_load_explicit(&stream_threshold, memory_order_relaxed);
+}
+
+/**
+ * @brief XOR data with key into caller-provided buffer
+ */
+enum crypto_status vernam_xor(
+    const unsigned char* data,
+    size_t data_len,
+    const unsigned char* key,
+    size_t key_len,
+    unsigned char* output
+)
+{
+    if (!data || !key || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (key_len < data_len)
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    select_kernel(data_len >= vernam_get_stream_threshold())(data, key, output, data_len);
+    return CRYPTO_SUCCESS;
+}
+
 /**
  * @brief Encrypt using Vernam cipher
  * 
@@ -25,10 +325,7 @@ enum crypto_status encrypt_vernam(
     if (!output)
         return CRYPTO_ERROR_MEMORY;
     
-    for (size_t i = 0; i < data_len; i++)
-    {
-        output[i] = data[i] ^ key[i];
-    }
+    vernam_xor(data, data_len, key, key_len, output);
     
     *result = output;
     return CRYPTO_SUCCESS;
@@ -47,21 +344,77 @@ enum crypto_status decrypt_vernam(
     unsigned char** result
 )
 {
-    if (!data || !key || !result)
+    return encrypt_vernam(data, data_len, key, key_len, result);
+}
+
+/**
+ * @brief XOR scatter/gather vectors with key
+ * 
+ * Key offset carries over segment boundaries.
+ */
+static enum crypto_status vernam_xor_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const unsigned char* key,
+    size_t key_len
+)
+{
+    if (!key)
         return CRYPTO_ERROR_NULL_POINTER;
     
-    if (key_len < data_len)
+    struct iov_cursor cursor;
+    size_t total;
+    size_t key_offset = 0;
+    const unsigned char* in;
+    unsigned char* out;
+    size_t run;
+    
+    enum crypto_status status = iov_cursor_init(&cursor, input, input_count, output, output_count, &total);
+    if (status != CRYPTO_SUCCESS)
+        return status;
+    
+    if (key_len < total)
         return CRYPTO_ERROR_INVALID_KEY;
     
-    unsigned char* output = (unsigned char*)malloc(data_len);
-    if (!output)
-        return CRYPTO_ERROR_MEMORY;
+    vernam_kernel kernel = select_kernel(total >= vernam_get_stream_threshold());
     
-    for (size_t i = 0; i < data_len; i++)
+    while ((run = iov_cursor_next(&cursor, &in, &out)) > 0)
     {
-        output[i] = data[i] ^ key[i];
+        kernel(in, key + key_offset, out, run);
+        key_offset += run;
     }
     
-    *result = output;
     return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt scatter/gather buffers using Vernam cipher
+ */
+enum crypto_status encrypt_vernam_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const unsigned char* key,
+    size_t key_len
+)
+{
+    return vernam_xor_iov(input, input_count, output, output_count, key, key_len);
+}
+
+/**
+ * @brief Decrypt scatter/gather buffers using Vernam cipher
+ */
+enum crypto_status decrypt_vernam_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const unsigned char* key,
+    size_t key_len
+)
+{
+    return vernam_xor_iov(input, input_count, output, output_count, key, key_len);
 }
\ No newline at end of file
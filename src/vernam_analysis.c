@@ -0,0 +1,413 @@
+#include "crypto/vernam.h"
+#include "parallel_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Leading bytes whose bit 7 forms the sketch of a ciphertext
+ */
+#define VERNAM_SKETCH_BYTES 32
+
+/**
+ * @brief Allowed bit 7 mismatches per byte (1 in 16)
+ * 
+ * Tolerates occasional non-ASCII plaintext bytes; unrelated ciphertexts
+ * disagree in about half of all bytes. The same rate is required of
+ * the sketch alone: 32 >> 4 = 2 mismatches.
+ */
+#define VERNAM_MISMATCH_SHIFT 4
+
+/**
+ * @brief Sketch nibbles left out of each bucket key
+ * 
+ * Sketches differing in at most 2 bits differ in at most 2 of their 8
+ * nibbles, so they agree exactly on the other 6. Every way to leave out
+ * 2 nibbles gives one 24-bit key; a matching pair shares at least one,
+ * and random sketches share a 24-bit key with about 1 in 2^24 others.
+ */
+#define VERNAM_SKETCH_KEYS 28
+
+/**
+ * @brief Sketch of one ciphertext, keyed by one bucket key
+ */
+struct sketch {
+    uint32_t key;
+    uint32_t bits;
+    size_t index;
+};
+
+/**
+ * @brief Positions of the two nibbles left out of key k (low < high)
+ */
+static void sketch_key_gap(unsigned k, unsigned* low, unsigned* high)
+{
+    unsigned first = 0;
+    
+    while (k >= 7 - first)
+        k -= 7 - first++;
+    
+    *low = first;
+    *high = first + 1 + k;
+}
+
+/**
+ * @brief Pack the 6 nibbles of bits outside nibbles low and high into 24 bits
+ */
+static uint32_t sketch_key(uint32_t bits, unsigned low, unsigned high)
+{
+    uint64_t wide = bits;
+    uint64_t below = wide & ((1ULL << low * 4) - 1);
+    uint64_t between = (wide >> (low + 1) * 4) & ((1ULL << (high - low - 1) * 4) - 1);
+    uint64_t above = wide >> (high + 1) * 4;
+    
+    return (uint32_t)(below | between << low * 4 | above << (high - 1) * 4);
+}
+
+/**
+ * @brief Sort sketches by 24-bit key, two 12-bit counting passes
+ * 
+ * Stable, so sketches with equal keys stay in index order.
+ */
+static void sketch_sort(struct sketch* items, struct sketch* temp, size_t count)
+{
+    static const unsigned shifts[2] = { 0, 12 };
+    struct sketch* from = items;
+    struct sketch* to = temp;
+    
+    for (unsigned pass = 0; pass < 2; pass++)
+    {
+        size_t offsets[4096] = {0};
+        
+        for (size_t i = 0; i < count; i++)
+            offsets[from[i].key >> shifts[pass] & 0xFFF]++;
+        
+        size_t sum = 0;
+        for (size_t b = 0; b < 4096; b++)
+        {
+            size_t n = offsets[b];
+            offsets[b] = sum;
+            sum += n;
+        }
+        
+        for (size_t i = 0; i < count; i++)
+            to[offsets[from[i].key >> shifts[pass] & 0xFFF]++] = from[i];
+        
+        struct sketch* swap = from;
+        from = to;
+        to = swap;
+    }
+}
+
+/**
+ * @brief Count set bits of sketch difference
+ */
+static unsigned sketch_mismatches(uint32_t differ)
+{
+    unsigned count = 0;
+    
+    for (; differ; differ &= differ - 1)
+        count++;
+    
+    return count;
+}
+
+/**
+ * @brief Check whether two sketches already met under an earlier key
+ */
+static int sketch_met_before(uint32_t x, uint32_t y, unsigned key)
+{
+    for (unsigned k = 0; k < key; k++)
+    {
+        unsigned low, high;
+        sketch_key_gap(k, &low, &high);
+        
+        if (sketch_key(x, low, high) == sketch_key(y, low, high))
+            return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Count bytes where bit 7 of a and b differs
+ */
+static size_t bit7_mismatches(const unsigned char* a, const unsigned char* b, size_t len)
+{
+    size_t count = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        
+        uint64_t flags = ((x ^ y) >> 7) & 0x0101010101010101ULL;
+        count += (size_t)((flags * 0x0101010101010101ULL) >> 56);
+    }
+    
+    for (; i < len; i++)
+        count += (size_t)((a[i] ^ b[i]) >> 7);
+    
+    return count;
+}
+
+/**
+ * @brief Find ciphertext pairs encrypted with the same key
+ * 
+ * With a shared key c1 ^ c2 = p1 ^ p2, and for ASCII plaintexts bit 7
+ * of every byte of that is zero: c1 and c2 agree in bit 7 almost
+ * everywhere. For every bucket key, ciphertexts are sorted by that key
+ * of the bit 7 pattern of their first bytes, and only those in the
+ * same bucket are compared in full, instead of all pairs. A pair
+ * sharing several keys is compared only under the first of them.
+ */
+enum crypto_status vernam_find_key_reuse(
+    const unsigned char* const* ciphertexts,
+    const size_t* lengths,
+    size_t count,
+    struct vernam_reuse_pair* pairs,
+    size_t max_pairs,
+    uint64_t* pair_count
+)
+{
+    if (!ciphertexts || !lengths || !pair_count || (!pairs && max_pairs))
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    struct sketch* sketches = (struct sketch*)malloc((count ? count : 1) * 2 * sizeof(struct sketch));
+    if (!sketches)
+        return CRYPTO_ERROR_MEMORY;
+    
+    struct sketch* temp = sketches + (count ? count : 1);
+    size_t indexed = 0;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        if (lengths[i] < VERNAM_SKETCH_BYTES)
+            continue;
+        
+        if (!ciphertexts[i])
+        {
+            free(sketches);
+            return CRYPTO_ERROR_NULL_POINTER;
+        }
+        
+        uint32_t bits = 0;
+        for (unsigned j = 0; j < VERNAM_SKETCH_BYTES; j++)
+            bits |= (uint32_t)(ciphertexts[i][j] >> 7) << j;
+        
+        sketches[indexed++] = (struct sketch){ 0, bits, i };
+    }
+    
+    uint64_t found = 0;
+    
+    for (unsigned key = 0; key < VERNAM_SKETCH_KEYS; key++)
+    {
+        unsigned low, high;
+        sketch_key_gap(key, &low, &high);
+        
+        for (size_t i = 0; i < indexed; i++)
+            sketches[i].key = sketch_key(sketches[i].bits, low, high);
+        
+        sketch_sort(sketches, temp, indexed);
+        
+        for (size_t start = 0; start < indexed; )
+        {
+            size_t end = start + 1;
+            while (end < indexed && sketches[end].key == sketches[start].key)
+                end++;
+            
+            for (size_t a = start; a < end; a++)
+            {
+                for (size_t b = a + 1; b < end; b++)
+                {
+                    if (sketch_met_before(sketches[a].bits, sketches[b].bits, key) ||
+                        sketch_mismatches(sketches[a].bits ^ sketches[b].bits) >
+                        VERNAM_SKETCH_BYTES >> VERNAM_MISMATCH_SHIFT)
+                        continue;
+                    
+                    size_t first = sketches[a].index;
+                    size_t second = sketches[b].index;
+                    size_t overlap = lengths[first] < lengths[second] ? lengths[first] : lengths[second];
+                    
+                    size_t mismatches = bit7_mismatches(ciphertexts[first], ciphertexts[second], overlap);
+                    
+                    if (mismatches > overlap >> VERNAM_MISMATCH_SHIFT)
+                        continue;
+                    
+                    if (found < max_pairs)
+                        pairs[found] = (struct vernam_reuse_pair){ first, second, overlap };
+                    found++;
+                }
+            }
+            
+            start = end;
+        }
+    }
+    
+    free(sketches);
+    
+    *pair_count = found;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief English likelihood weight of one byte
+ * 
+ * Letters weigh by frequency (per mille), space most,
+ * control and non-ASCII bytes count against the text.
+ */
+static void english_weights(int weights[256])
+{
+    static const int letters[26] = {
+        82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24,
+        67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1
+    };
+    
+    for (int c = 0; c < 256; c++)
+    {
+        if (c >= 'a' && c <= 'z')
+            weights[c] = letters[c - 'a'];
+        else if (c >= 'A' && c <= 'Z')
+            weights[c] = letters[c - 'A'] / 2;
+        else if (c == ' ')
+            weights[c] = 130;
+        else if (c != 0 && strchr(".,;:'\"!?-()", c))
+            weights[c] = 10;
+        else if (c >= '0' && c <= '9')
+            weights[c] = 5;
+        else if (c == '\n')
+            weights[c] = 5;
+        else if (c >= 0x20 && c < 0x7F)
+            weights[c] = -20;
+        else
+            weights[c] = -200;
+    }
+}
+
+/**
+ * @brief Crib dragging work of one thread: pairs offset .. offset + length - 1
+ */
+struct crib_slice {
+    const unsigned char* const* ciphertexts;
+    const size_t* lengths;
+    const struct vernam_reuse_pair* pairs;
+    const unsigned char* crib;
+    size_t crib_len;
+    const int* weights;
+    struct vernam_crib_hit* hits;
+    size_t offset;
+    size_t length;
+    enum crypto_status status;
+};
+
+/**
+ * @brief Slide crib over c1 ^ c2 of each pair, keep best scoring position
+ */
+static void* crib_slice_run(void* arg)
+{
+    struct crib_slice* slice = (struct crib_slice*)arg;
+    size_t capacity = 0;
+    unsigned char* x = NULL;
+    
+    slice->status = CRYPTO_SUCCESS;
+    memset(slice->hits + slice->offset, 0, slice->length * sizeof(struct vernam_crib_hit));
+    
+    for (size_t p = slice->offset; p < slice->offset + slice->length; p++)
+    {
+        const struct vernam_reuse_pair* pair = &slice->pairs[p];
+        struct vernam_crib_hit* hit = &slice->hits[p];
+        size_t len = slice->lengths[pair->first] < slice->lengths[pair->second] ?
+            slice->lengths[pair->first] : slice->lengths[pair->second];
+        
+        if (len < slice->crib_len)
+            continue;
+        
+        if (len > capacity)
+        {
+            unsigned char* grown = (unsigned char*)realloc(x, len);
+            if (!grown)
+            {
+                slice->status = CRYPTO_ERROR_MEMORY;
+                break;
+            }
+            x = grown;
+            capacity = len;
+        }
+        
+        vernam_xor(slice->ciphertexts[pair->first], len, slice->ciphertexts[pair->second], len, x);
+        
+        for (size_t pos = 0; pos + slice->crib_len <= len; pos++)
+        {
+            long score = 0;
+            
+            for (size_t j = 0; j < slice->crib_len; j++)
+                score += slice->weights[x[pos + j] ^ slice->crib[j]];
+            
+            if (!hit->found || score > hit->score)
+            {
+                hit->position = pos;
+                hit->score = score;
+                hit->found = 1;
+            }
+        }
+    }
+    
+    free(x);
+    return NULL;
+}
+
+/**
+ * @brief Crib-drag candidate pairs on several threads
+ */
+enum crypto_status vernam_crib_drag(
+    const unsigned char* const* ciphertexts,
+    const size_t* lengths,
+    const struct vernam_reuse_pair* pairs,
+    size_t pair_count,
+    const unsigned char* crib,
+    size_t crib_len,
+    size_t threads,
+    struct vernam_crib_hit* hits
+)
+{
+    if (!ciphertexts || !lengths || !crib || (!pairs && pair_count) || (!hits && pair_count))
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (crib_len == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    for (size_t p = 0; p < pair_count; p++)
+    {
+        if (!ciphertexts[pairs[p].first] || !ciphertexts[pairs[p].second])
+            return CRYPTO_ERROR_NULL_POINTER;
+    }
+    
+    int weights[256];
+    english_weights(weights);
+    
+    struct crib_slice slices[PARALLEL_MAX_THREADS];
+    size_t count = parallel_thread_count(pair_count, threads, 1);
+    size_t step = (pair_count + count - 1) / count;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t offset = i * step < pair_count ? i * step : pair_count;
+        size_t end = offset + step < pair_count ? offset + step : pair_count;
+        
+        slices[i] = (struct crib_slice){ ciphertexts, lengths, pairs, crib, crib_len, weights,
+            hits, offset, end - offset, CRYPTO_SUCCESS };
+    }
+    
+    parallel_run(crib_slice_run, slices, sizeof(struct crib_slice), count);
+    
+    enum crypto_status status = slices[0].status;
+    
+    for (size_t i = 1; i < count; i++)
+    {
+        if (slices[i].length && slices[i].status != CRYPTO_SUCCESS)
+            status = slices[i].status;
+    }
+    
+    return status;
+}
\ No newline at end of file
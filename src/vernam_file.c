@@ -0,0 +1,212 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "crypto/vernam.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Bytes mapped at once from each file
+ * 
+ * Keeps address space and resident set bounded for multi-GB files;
+ * a multiple of any page size in use.
+ */
+#define VERNAM_FILE_WINDOW ((size_t)64 * 1024 * 1024)
+
+/**
+ * @brief Map window of file, hinting sequential access
+ * 
+ * @return Mapping, MAP_FAILED on error
+ */
+static void* map_window(int fd, off_t offset, size_t len, int prot)
+{
+    void* map = mmap(NULL, len, prot, MAP_SHARED, fd, offset);
+    
+    if (map != MAP_FAILED)
+        posix_madvise(map, len, POSIX_MADV_SEQUENTIAL);
+    
+    return map;
+}
+
+/**
+ * @brief Open key file and check it covers data_len bytes
+ * 
+ * @param st Output key file status
+ * @return File descriptor, -1 on error (status set)
+ */
+static int open_key(const char* key_path, off_t data_len, struct stat* st, enum crypto_status* status)
+{
+    int fd = open(key_path, O_RDONLY);
+    
+    if (fd < 0)
+    {
+        *status = CRYPTO_ERROR_EXECUTION;
+        return -1;
+    }
+    
+    if (fstat(fd, st) != 0)
+    {
+        close(fd);
+        *status = CRYPTO_ERROR_EXECUTION;
+        return -1;
+    }
+    
+    if (st->st_size < data_len)
+    {
+        close(fd);
+        *status = CRYPTO_ERROR_INVALID_KEY;
+        return -1;
+    }
+    
+    return fd;
+}
+
+/**
+ * @brief XOR file windows: out = data ^ key
+ * 
+ * If out_fd == data_fd, data is rewritten in place through one
+ * read-write mapping.
+ */
+static enum crypto_status xor_windows(int data_fd, int key_fd, int out_fd, off_t len)
+{
+    int in_place = out_fd == data_fd;
+    
+    for (off_t offset = 0; offset < len; offset += (off_t)VERNAM_FILE_WINDOW)
+    {
+        size_t window = VERNAM_FILE_WINDOW;
+        if ((off_t)window > len - offset)
+            window = (size_t)(len - offset);
+        
+        unsigned char* data = (unsigned char*)map_window(data_fd, offset, window,
+            in_place ? PROT_READ | PROT_WRITE : PROT_READ);
+        if (data == MAP_FAILED)
+            return CRYPTO_ERROR_EXECUTION;
+        
+        unsigned char* key = (unsigned char*)map_window(key_fd, offset, window, PROT_READ);
+        if (key == MAP_FAILED)
+        {
+            munmap(data, window);
+            return CRYPTO_ERROR_EXECUTION;
+        }
+        
+        unsigned char* out = data;
+        if (!in_place)
+        {
+            out = (unsigned char*)map_window(out_fd, offset, window, PROT_READ | PROT_WRITE);
+            if (out == MAP_FAILED)
+            {
+                munmap(key, window);
+                munmap(data, window);
+                return CRYPTO_ERROR_EXECUTION;
+            }
+        }
+        
+        vernam_xor(data, window, key, window, out);
+        
+        if (!in_place)
+            munmap(out, window);
+        munmap(key, window);
+        munmap(data, window);
+    }
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Vernam XOR of file into new file
+ */
+enum crypto_status vernam_xor_file(
+    const char* data_path,
+    const char* key_path,
+    const char* output_path
+)
+{
+    if (!data_path || !key_path || !output_path)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    struct stat data_st;
+    struct stat key_st;
+    struct stat out_st;
+    enum crypto_status status = CRYPTO_ERROR_EXECUTION;
+    
+    int data_fd = open(data_path, O_RDONLY);
+    if (data_fd < 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    if (fstat(data_fd, &data_st) != 0)
+    {
+        close(data_fd);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    int key_fd = open_key(key_path, data_st.st_size, &key_st, &status);
+    if (key_fd < 0)
+    {
+        close(data_fd);
+        return status;
+    }
+    
+    int out_fd = open(output_path, O_RDWR | O_CREAT, 0644);
+    if (out_fd < 0)
+    {
+        close(key_fd);
+        close(data_fd);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    if (fstat(out_fd, &out_st) != 0)
+        status = CRYPTO_ERROR_EXECUTION;
+    else if (out_st.st_dev == data_st.st_dev && out_st.st_ino == data_st.st_ino)
+        status = CRYPTO_ERROR_INVALID_INPUT;
+    else if (out_st.st_dev == key_st.st_dev && out_st.st_ino == key_st.st_ino)
+        status = CRYPTO_ERROR_INVALID_INPUT;
+    else if (ftruncate(out_fd, data_st.st_size) != 0)
+        status = CRYPTO_ERROR_EXECUTION;
+    else
+        status = xor_windows(data_fd, key_fd, out_fd, data_st.st_size);
+    
+    close(out_fd);
+    close(key_fd);
+    close(data_fd);
+    return status;
+}
+
+/**
+ * @brief Vernam XOR of file in place
+ */
+enum crypto_status vernam_xor_file_in_place(const char* path, const char* key_path)
+{
+    if (!path || !key_path)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    struct stat st;
+    struct stat key_st;
+    enum crypto_status status = CRYPTO_ERROR_EXECUTION;
+    
+    int fd = open(path, O_RDWR);
+    if (fd < 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    int key_fd = open_key(key_path, st.st_size, &key_st, &status);
+    if (key_fd < 0)
+    {
+        close(fd);
+        return status;
+    }
+    
+    if (key_st.st_dev == st.st_dev && key_st.st_ino == st.st_ino)
+        status = CRYPTO_ERROR_INVALID_INPUT;
+    else
+        status = xor_windows(fd, key_fd, fd, st.st_size);
+    
+    close(key_fd);
+    close(fd);
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+/**
+ * @file vernam_internal.h
+ * @brief XOR kernels shared with other ciphers
+ * 
+ * Not part of the public API.
+ */
+
+#ifndef CRYPTO_VERNAM_INTERNAL_H
+#define CRYPTO_VERNAM_INTERNAL_H
+
+#include <stddef.h>
+
+/**
+ * @brief XOR data with key using the widest kernel of this CPU
+ * 
+ * Lets callers that produce key bytes in chunks make the streaming
+ * decision once for their whole output (see vernam_get_stream_threshold).
+ * 
+ * @param data Input bytes
+ * @param key Key bytes (at least len)
+ * @param out Output bytes (may equal data)
+ * @param len Number of bytes
+ * @param stream Nonzero to write out with non-temporal stores
+ */
+void vernam_xor_kernel(const unsigned char* data, const unsigned char* key, unsigned char* out, size_t len, int stream);
+
+#endif
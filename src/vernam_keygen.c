@@ -0,0 +1,219 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "crypto/vernam.h"
+#include "parallel_internal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+
+/**
+ * @brief Bytes generated and written per I/O request
+ * 
+ * Multiple of any page and disk block size, so file writes are aligned.
+ */
+#define VERNAM_KEYGEN_CHUNK ((size_t)4 * 1024 * 1024)
+
+#define VERNAM_KEYGEN_ALIGN 4096
+
+/**
+ * @brief Fill buffer from /dev/urandom
+ */
+static enum crypto_status urandom_fill(unsigned char* buffer, size_t len)
+{
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    while (len > 0)
+    {
+        ssize_t got = read(fd, buffer, len);
+        
+        if (got < 0 && errno == EINTR)
+            continue;
+        
+        if (got <= 0)
+        {
+            close(fd);
+            return CRYPTO_ERROR_EXECUTION;
+        }
+        
+        buffer += got;
+        len -= (size_t)got;
+    }
+    
+    close(fd);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Fill buffer with random bytes from the kernel
+ * 
+ * getrandom() where available (one system call per 32 MiB at most),
+ * /dev/urandom otherwise.
+ */
+static enum crypto_status random_fill(unsigned char* buffer, size_t len)
+{
+#ifdef __linux__
+    while (len > 0)
+    {
+        ssize_t got = getrandom(buffer, len, 0);
+        
+        if (got < 0 && errno == EINTR)
+            continue;
+        
+        if (got < 0 && errno == ENOSYS)
+            return urandom_fill(buffer, len);
+        
+        if (got <= 0)
+            return CRYPTO_ERROR_EXECUTION;
+        
+        buffer += got;
+        len -= (size_t)got;
+    }
+    
+    return CRYPTO_SUCCESS;
+#else
+    return urandom_fill(buffer, len);
+#endif
+}
+
+/**
+ * @brief Generate random key into caller-provided buffer
+ */
+enum crypto_status vernam_generate_key(unsigned char* key, size_t key_len)
+{
+    if (!key)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (key_len == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    return random_fill(key, key_len);
+}
+
+/**
+ * @brief Work item of one thread: file bytes offset .. offset + length - 1
+ */
+struct keygen_slice {
+    int fd;
+    uint64_t offset;
+    uint64_t length;
+    enum crypto_status status;
+};
+
+/**
+ * @brief Generate and write one slice, chunk by chunk, with own buffer
+ */
+static void* keygen_slice_run(void* arg)
+{
+    struct keygen_slice* slice = (struct keygen_slice*)arg;
+    void* memory = NULL;
+    
+    slice->status = CRYPTO_SUCCESS;
+    
+    if (slice->length == 0)
+        return NULL;
+    
+    if (posix_memalign(&memory, VERNAM_KEYGEN_ALIGN, VERNAM_KEYGEN_CHUNK) != 0)
+    {
+        slice->status = CRYPTO_ERROR_MEMORY;
+        return NULL;
+    }
+    
+    unsigned char* buffer = (unsigned char*)memory;
+    uint64_t done = 0;
+    
+    while (done < slice->length && slice->status == CRYPTO_SUCCESS)
+    {
+        size_t chunk = VERNAM_KEYGEN_CHUNK;
+        if (chunk > slice->length - done)
+            chunk = (size_t)(slice->length - done);
+        
+        slice->status = random_fill(buffer, chunk);
+        
+        for (size_t written = 0; slice->status == CRYPTO_SUCCESS && written < chunk; )
+        {
+            ssize_t n = pwrite(slice->fd, buffer + written, chunk - written,
+                (off_t)(slice->offset + done + written));
+            
+            if (n < 0 && errno == EINTR)
+                continue;
+            
+            if (n <= 0)
+                slice->status = CRYPTO_ERROR_EXECUTION;
+            else
+                written += (size_t)n;
+        }
+        
+        done += chunk;
+    }
+    
+    memset(buffer, 0, VERNAM_KEYGEN_CHUNK);
+    free(memory);
+    return NULL;
+}
+
+/**
+ * @brief Generate random pad file on several threads
+ */
+enum crypto_status vernam_generate_key_file(const char* path, uint64_t size, size_t threads)
+{
+    if (!path)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (size == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    if (ftruncate(fd, (off_t)size) != 0)
+    {
+        close(fd);
+        unlink(path);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    struct keygen_slice slices[PARALLEL_MAX_THREADS];
+    uint64_t chunks = (size + VERNAM_KEYGEN_CHUNK - 1) / VERNAM_KEYGEN_CHUNK;
+    size_t items = chunks < PARALLEL_MAX_THREADS ? (size_t)chunks : PARALLEL_MAX_THREADS;
+    size_t count = parallel_thread_count(items, threads, 1);
+    uint64_t step = (chunks + count - 1) / count * VERNAM_KEYGEN_CHUNK;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t offset = i * step < size ? i * step : size;
+        uint64_t end = offset + step < size ? offset + step : size;
+        
+        slices[i] = (struct keygen_slice){ fd, offset, end - offset, CRYPTO_SUCCESS };
+    }
+    
+    parallel_run(keygen_slice_run, slices, sizeof(struct keygen_slice), count);
+    
+    enum crypto_status status = slices[0].status;
+    
+    for (size_t i = 1; i < count; i++)
+    {
+        if (slices[i].length && slices[i].status != CRYPTO_SUCCESS)
+            status = slices[i].status;
+    }
+    
+    if (status == CRYPTO_SUCCESS && fdatasync(fd) != 0)
+        status = CRYPTO_ERROR_EXECUTION;
+    
+    if (close(fd) != 0 && status == CRYPTO_SUCCESS)
+        status = CRYPTO_ERROR_EXECUTION;
+    
+    if (status != CRYPTO_SUCCESS)
+        unlink(path);
+    
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,411 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "crypto/vernam.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief "VPADSTAT" in little-endian
+ */
+#define VERNAM_PAD_MAGIC 0x5441545344415056ULL
+
+/**
+ * @brief First lease of a store, doubled on every refill
+ */
+#define VERNAM_PAD_LEASE_MIN 256
+
+/**
+ * @brief Largest lease, bounds pad bytes lost in a crash
+ */
+#define VERNAM_PAD_LEASE_MAX (1ULL << 20)
+
+/**
+ * @brief Layout of pad state file
+ * 
+ * leased is the high-water mark of pad bytes handed to any store.
+ * It is mapped shared and synced to disk before the bytes of a new
+ * lease are used, so after a crash the unused rest of every lease is
+ * skipped and no pad byte is handed out twice.
+ */
+struct vernam_pad_state {
+    uint64_t magic;
+    uint64_t pad_size;
+    _Atomic uint64_t leased;
+};
+
+/**
+ * @brief Pad store: mapped pad, mapped state and current lease
+ * 
+ * Reservations take bytes from [next, limit) with a compare-and-swap
+ * and touch neither the state file nor the lock. Only a refill of the
+ * lease takes the lock and waits for the disk.
+ */
+struct vernam_pad {
+    const unsigned char* key;
+    uint64_t size;
+    struct vernam_pad_state* state;
+    _Atomic uint64_t next;
+    _Atomic uint64_t limit;
+    uint64_t lease;
+    pthread_mutex_t lock;
+};
+
+/**
+ * @brief Create initialized state file unless one exists
+ * 
+ * Header is written to a temporary file first and then linked into
+ * place, so no process ever sees a half-initialized state file and a
+ * concurrent creator can never reset an offset already in use.
+ */
+static enum crypto_status create_state(const char* state_path, uint64_t pad_size)
+{
+    size_t path_len = strlen(state_path);
+    char* temp_path = (char*)malloc(path_len + sizeof(".XXXXXX"));
+    if (!temp_path)
+        return CRYPTO_ERROR_MEMORY;
+    
+    memcpy(temp_path, state_path, path_len);
+    memcpy(temp_path + path_len, ".XXXXXX", sizeof(".XXXXXX"));
+    
+    int fd = mkstemp(temp_path);
+    if (fd < 0)
+    {
+        free(temp_path);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    struct vernam_pad_state initial;
+    memset(&initial, 0, sizeof(initial));
+    initial.magic = VERNAM_PAD_MAGIC;
+    initial.pad_size = pad_size;
+    atomic_init(&initial.leased, 0);
+    
+    enum crypto_status status = CRYPTO_SUCCESS;
+    
+    if (write(fd, &initial, sizeof(initial)) != (ssize_t)sizeof(initial) || fsync(fd) != 0)
+        status = CRYPTO_ERROR_EXECUTION;
+    
+    if (close(fd) != 0)
+        status = CRYPTO_ERROR_EXECUTION;
+    
+    if (status == CRYPTO_SUCCESS && link(temp_path, state_path) != 0 && errno != EEXIST)
+        status = CRYPTO_ERROR_EXECUTION;
+    
+    unlink(temp_path);
+    free(temp_path);
+    return status;
+}
+
+/**
+ * @brief Map state file, creating it if missing
+ */
+static enum crypto_status map_state(const char* state_path, uint64_t pad_size, struct vernam_pad_state** state)
+{
+    struct stat st;
+    int fd = open(state_path, O_RDWR);
+    
+    if (fd < 0 && errno == ENOENT)
+    {
+        enum crypto_status status = create_state(state_path, pad_size);
+        if (status != CRYPTO_SUCCESS)
+            return status;
+        
+        fd = open(state_path, O_RDWR);
+    }
+    
+    if (fd < 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    if (st.st_size != (off_t)sizeof(struct vernam_pad_state))
+    {
+        close(fd);
+        return CRYPTO_ERROR_INVALID_INPUT;
+    }
+    
+    void* map = mmap(NULL, sizeof(struct vernam_pad_state), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    
+    if (map == MAP_FAILED)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    struct vernam_pad_state* result = (struct vernam_pad_state*)map;
+    
+    if (result->magic != VERNAM_PAD_MAGIC || result->pad_size != pad_size)
+    {
+        munmap(map, sizeof(struct vernam_pad_state));
+        return CRYPTO_ERROR_INVALID_KEY;
+    }
+    
+    *state = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Open pad store
+ */
+enum crypto_status vernam_pad_open(const char* pad_path, const char* state_path, struct vernam_pad** pad)
+{
+    if (!pad_path || !state_path || !pad)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    struct stat st;
+    int fd = open(pad_path, O_RDONLY);
+    
+    if (fd < 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return CRYPTO_ERROR_INVALID_KEY;
+    }
+    
+    struct vernam_pad* result = (struct vernam_pad*)malloc(sizeof(struct vernam_pad));
+    if (!result)
+    {
+        close(fd);
+        return CRYPTO_ERROR_MEMORY;
+    }
+    
+    result->size = (uint64_t)st.st_size;
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    
+    if (map == MAP_FAILED)
+    {
+        free(result);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    result->key = (const unsigned char*)map;
+    atomic_init(&result->next, 0);
+    atomic_init(&result->limit, 0);
+    result->lease = VERNAM_PAD_LEASE_MIN;
+    
+    enum crypto_status status = map_state(state_path, result->size, &result->state);
+    if (status != CRYPTO_SUCCESS)
+    {
+        munmap(map, (size_t)result->size);
+        free(result);
+        return status;
+    }
+    
+    if (pthread_mutex_init(&result->lock, NULL) != 0)
+    {
+        munmap(result->state, sizeof(struct vernam_pad_state));
+        munmap(map, (size_t)result->size);
+        free(result);
+        return CRYPTO_ERROR_EXECUTION;
+    }
+    
+    *pad = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Close pad store
+ */
+void vernam_pad_close(struct vernam_pad* pad)
+{
+    if (!pad)
+        return;
+    
+    uint64_t limit = atomic_load(&pad->limit);
+    
+    /* Give back unused end of lease unless another store leased after it */
+    atomic_compare_exchange_strong(&pad->state->leased, &limit, atomic_load(&pad->next));
+    
+    msync(pad->state, sizeof(struct vernam_pad_state), MS_SYNC);
+    pthread_mutex_destroy(&pad->lock);
+    munmap(pad->state, sizeof(struct vernam_pad_state));
+    munmap((void*)pad->key, (size_t)pad->size);
+    free(pad);
+}
+
+/**
+ * @brief Bytes of pad not yet reserved
+ */
+enum crypto_status vernam_pad_remaining(struct vernam_pad* pad, uint64_t* remaining)
+{
+    if (!pad || !remaining)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    pthread_mutex_lock(&pad->lock);
+    *remaining = pad->size - atomic_load(&pad->state->leased) + atomic_load(&pad->limit) - atomic_load(&pad->next);
+    pthread_mutex_unlock(&pad->lock);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Reserve len bytes of current lease
+ * 
+ * Compare-and-swap loop instead of a plain fetch-add, so a request that
+ * does not fit never moves next past the end of the lease. next is
+ * loaded before limit and a refill moves next before limit, so a stale
+ * pair always fails the check or the swap.
+ * 
+ * @return 0 if lease is too short
+ */
+static int lease_reserve(struct vernam_pad* pad, size_t len, uint64_t* offset)
+{
+    uint64_t current = atomic_load(&pad->next);
+    
+    do
+    {
+        uint64_t limit = atomic_load(&pad->limit);
+        
+        if (current > limit || len > limit - current)
+            return 0;
+    }
+    while (!atomic_compare_exchange_weak(&pad->next, &current, current + len));
+    
+    *offset = current;
+    return 1;
+}
+
+/**
+ * @brief Lease pad bytes for at least len more
+ * 
+ * New lease is taken from the shared high-water mark and synced to disk
+ * before use. A lease that directly follows the current one extends it,
+ * otherwise the rest of the current lease is dropped. Caller holds lock.
+ */
+static enum crypto_status lease_extend(struct vernam_pad* pad, size_t len)
+{
+    uint64_t next = atomic_load(&pad->next);
+    uint64_t limit = atomic_load(&pad->limit);
+    uint64_t start = atomic_load(&pad->state->leased);
+    uint64_t take;
+    int extend;
+    
+    do
+    {
+        extend = start == limit;
+        uint64_t need = extend ? len - (limit - next) : len;
+        
+        if (need > pad->size - start)
+            return CRYPTO_ERROR_INVALID_KEY;
+        
+        take = need > pad->lease ? need : pad->lease;
+        if (take > pad->size - start)
+            take = pad->size - start;
+    }
+    while (!atomic_compare_exchange_weak(&pad->state->leased, &start, start + take));
+    
+    if (msync(pad->state, sizeof(struct vernam_pad_state), MS_SYNC) != 0)
+        return CRYPTO_ERROR_EXECUTION;
+    
+    if (!extend)
+        atomic_store(&pad->next, start);
+    atomic_store(&pad->limit, start + take);
+    
+    if (pad->lease < VERNAM_PAD_LEASE_MAX)
+        pad->lease *= 2;
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Reserve len pad bytes, leasing more when needed
+ */
+static enum crypto_status pad_reserve(struct vernam_pad* pad, size_t len, uint64_t* offset)
+{
+    if (lease_reserve(pad, len, offset))
+        return CRYPTO_SUCCESS;
+    
+    enum crypto_status status = CRYPTO_SUCCESS;
+    pthread_mutex_lock(&pad->lock);
+    
+    /* Another thread may refill first, or use up a new lease before this one reserves */
+    while (status == CRYPTO_SUCCESS && !lease_reserve(pad, len, offset))
+        status = lease_extend(pad, len);
+    
+    pthread_mutex_unlock(&pad->lock);
+    return status;
+}
+
+/**
+ * @brief Encrypt with fresh pad bytes
+ */
+enum crypto_status vernam_pad_encrypt(
+    struct vernam_pad* pad,
+    const unsigned char* data,
+    size_t data_len,
+    uint64_t* pad_offset,
+    unsigned char** result
+)
+{
+    if (!pad || !data || !pad_offset || !result)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (data_len == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    unsigned char* output = (unsigned char*)malloc(data_len);
+    if (!output)
+        return CRYPTO_ERROR_MEMORY;
+    
+    uint64_t offset;
+    enum crypto_status status = pad_reserve(pad, data_len, &offset);
+    if (status != CRYPTO_SUCCESS)
+    {
+        free(output);
+        return status;
+    }
+    
+    vernam_xor(data, data_len, pad->key + offset, data_len, output);
+    
+    *pad_offset = offset;
+    *result = output;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Decrypt with pad bytes reserved at pad_offset
+ */
+enum crypto_status vernam_pad_decrypt(
+    struct vernam_pad* pad,
+    const unsigned char* data,
+    size_t data_len,
+    uint64_t pad_offset,
+    unsigned char** result
+)
+{
+    if (!pad || !data || !result)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (data_len == 0)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    uint64_t leased = atomic_load(&pad->state->leased);
+    if (pad_offset > leased || data_len > leased - pad_offset)
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    unsigned char* output = (unsigned char*)malloc(data_len);
+    if (!output)
+        return CRYPTO_ERROR_MEMORY;
+    
+    vernam_xor(data, data_len, pad->key + pad_offset, data_len, output);
+    
+    *result = output;
+    return CRYPTO_SUCCESS;
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "crypto/vigenere.h"
+#include "iov_internal.h"
+#include "letter_parallel_internal.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -45,6 +47,51 @@ static int is_valid_key(const char* key)
     return 1;
 }
 
+/**
+ * @brief Shift letters of len characters by repeating key
+ * 
+ * @param in Input characters
+ * @param out Output characters (may equal in)
+ * @param len Number of characters
+ * @param key Validated keyword
+ * @param key_len Keyword length
+ * @param key_pos Key position of first letter (advanced past run)
+ * @param direction 1 to encrypt, -1 to decrypt
+ */
+static void vigenere_run(
+    const char* in,
+    char* out,
+    size_t len,
+    const char* key,
+    size_t key_len,
+    size_t* key_pos,
+    int direction
+)
+{
+    size_t pos = *key_pos;
+    
+    for (size_t i = 0; i < len; i++)
+    {
+        if (is_letter(in[i]))
+        {
+            int shift = char_to_pos(key[pos % key_len]);
+            if (direction < 0)
+                shift = 26 - shift;
+            
+            char base = 'A' + (in[i] & 32);
+            out[i] = (in[i] - base + shift) % 26 + base;
+            
+            pos++;
+        }
+        else 
+        {
+            out[i] = in[i];
+        }
+    }
+    
+    *key_pos = pos;
+}
+
 /**
  * @brief Encrypt plaintext using Vigenere cipher
  * 
@@ -66,24 +113,7 @@ enum crypto_status encrypt_vigenere(const char* plaintext, const char* key, char
         return CRYPTO_ERROR_MEMORY;
     
     size_t key_pos = 0;
-    
-    
-    for (size_t i = 0; i < len; i++)
-    {
-        if (is_letter(plaintext[i]))
-        {
-            int shift = char_to_pos(key[key_pos % key_len]);
-            
-            char base = 'A' + (plaintext[i] & 32);
-            result[i] = (plaintext[i] - base + shift) % 26 + base;
-            
-            key_pos++;
-        }
-        else 
-        {
-            result[i] = plaintext[i];
-        }
-    }
+    vigenere_run(plaintext, result, len, key, key_len, &key_pos, 1);
     
     result[len] = '\0';
     *ciphertext = result;
@@ -112,25 +142,233 @@ enum crypto_status decrypt_vigenere(const char* ciphertext, const char* key, cha
         return CRYPTO_ERROR_MEMORY;
     
     size_t key_pos = 0;
+    vigenere_run(ciphertext, result, len, key, key_len, &key_pos, -1);
     
-    for (size_t i = 0; i < len; i++)
+    result[len] = '\0';
+    *plaintext = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Apply Vigenere cipher over scatter/gather vectors
+ * 
+ * Key position carries over segment boundaries.
+ */
+static enum crypto_status vigenere_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const char* key,
+    int direction
+)
+{
+    if (!key)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    struct iov_cursor cursor;
+    size_t total;
+    const unsigned char* in;
+    unsigned char* out;
+    size_t run;
+    
+    enum crypto_status status = iov_cursor_init(&cursor, input, input_count, output, output_count, &total);
+    if (status != CRYPTO_SUCCESS)
+        return status;
+    
+    if (!is_valid_key(key))
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    size_t key_len = strlen(key);
+    size_t key_pos = 0;
+    
+    while ((run = iov_cursor_next(&cursor, &in, &out)) > 0)
+        vigenere_run((const char*)in, (char*)out, run, key, key_len, &key_pos, direction);
+    
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt scatter/gather buffers using Vigenere cipher
+ */
+enum crypto_status encrypt_vigenere_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const char* key
+)
+{
+    return vigenere_iov(input, input_count, output, output_count, key, 1);
+}
+
+/**
+ * @brief Decrypt scatter/gather buffers using Vigenere cipher
+ */
+enum crypto_status decrypt_vigenere_iov(
+    const struct iovec* input,
+    size_t input_count,
+    const struct iovec* output,
+    size_t output_count,
+    const char* key
+)
+{
+    return vigenere_iov(input, input_count, output, output_count, key, -1);
+}
+
+/**
+ * @brief Start streaming Vigenere transformation
+ */
+enum crypto_status vigenere_stream_init(
+    struct vigenere_stream_ctx* ctx,
+    const char* key,
+    int decrypt,
+    size_t letter_offset
+)
+{
+    if (!ctx || !key)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (!is_valid_key(key))
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    ctx->key = key;
+    ctx->key_len = strlen(key);
+    ctx->key_pos = letter_offset;
+    ctx->direction = decrypt ? -1 : 1;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Transform next chunk; key position carries over chunks
+ */
+enum crypto_status vigenere_stream_update(
+    struct vigenere_stream_ctx* ctx,
+    const char* input,
+    size_t input_len,
+    char* output
+)
+{
+    if (!ctx || !input || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (!ctx->key)
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    vigenere_run(input, output, input_len, ctx->key, ctx->key_len, &ctx->key_pos, ctx->direction);
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Finish streaming Vigenere transformation
+ */
+enum crypto_status vigenere_stream_final(struct vigenere_stream_ctx* ctx)
+{
+    if (!ctx)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    memset(ctx, 0, sizeof(*ctx));
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Decrypt byte range of Vigenere ciphertext
+ */
+enum crypto_status decrypt_vigenere_range(
+    const char* ciphertext,
+    size_t ciphertext_len,
+    const struct letter_index* index,
+    const char* key,
+    size_t offset,
+    size_t length,
+    char** plaintext
+)
+{
+    if (!ciphertext || !key || !plaintext)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (!is_valid_key(key))
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    if (length == 0 || offset > ciphertext_len || length > ciphertext_len - offset)
+        return CRYPTO_ERROR_INVALID_INPUT;
+    
+    size_t letter_pos;
+    
+    if (index)
     {
-        if (is_letter(ciphertext[i]))
-        {
-            int shift = char_to_pos(key[key_pos % key_len]);
-            
-            char base = 'A' + (ciphertext[i] & 32);
-            result[i] = (ciphertext[i] - base - shift + 26) % 26 + base;
-            
-            key_pos++;
-        }
-        else 
-        {
-            result[i] = ciphertext[i];
-        }
+        if (index->text_len != ciphertext_len)
+            return CRYPTO_ERROR_INVALID_INPUT;
+        
+        enum crypto_status status = letter_index_position(index, ciphertext, offset, &letter_pos);
+        if (status != CRYPTO_SUCCESS)
+            return status;
     }
+    else
+        letter_pos = letter_count(ciphertext, offset);
     
-    result[len] = '\0';
+    char* result = (char*)malloc(length + 1);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    vigenere_run(ciphertext + offset, result, length, key, strlen(key), &letter_pos, -1);
+    
+    result[length] = '\0';
     *plaintext = result;
     return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Vigenere parameters of parallel chunks
+ */
+struct vigenere_params {
+    const char* key;
+    size_t key_len;
+    int direction;
+};
+
+static void vigenere_chunk(const char* in, char* out, size_t len, size_t letter_pos, const void* arg)
+{
+    const struct vigenere_params* params = (const struct vigenere_params*)arg;
+    vigenere_run(in, out, len, params->key, params->key_len, &letter_pos, params->direction);
+}
+
+/**
+ * @brief Apply Vigenere cipher on several threads
+ */
+static enum crypto_status vigenere_parallel(const char* input, const char* key, size_t threads, int direction, char** output)
+{
+    if (!input || !key || !output)
+        return CRYPTO_ERROR_NULL_POINTER;
+    
+    if (!is_valid_key(key))
+        return CRYPTO_ERROR_INVALID_KEY;
+    
+    size_t len = strlen(input);
+    char* result = (char*)malloc(len + 1);
+    if (!result)
+        return CRYPTO_ERROR_MEMORY;
+    
+    struct vigenere_params params = { key, strlen(key), direction };
+    letter_parallel_run(input, result, len, threads, vigenere_chunk, &params);
+    
+    result[len] = '\0';
+    *output = result;
+    return CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Encrypt plaintext using Vigenere cipher on several threads
+ */
+enum crypto_status encrypt_vigenere_parallel(const char* plaintext, const char* key, size_t threads, char** ciphertext)
+{
+    return vigenere_parallel(plaintext, key, threads, 1, ciphertext);
+}
+
+/**
+ * @brief Decrypt ciphertext using Vigenere cipher on several threads
+ */
+enum crypto_status decrypt_vigenere_parallel(const char* ciphertext, const char* key, size_t threads, char** plaintext)
+{
+    return vigenere_parallel(ciphertext, key, threads, -1, plaintext);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <cryptography.h>
 #include <check.h>
 #include <stdlib.h>
+#include <string.h>
 
 START_TEST(test_encrypt_basic)
 {
@@ -120,6 +121,173 @@ START_TEST(test_case_preservation)
 } 
 END_TEST
 
+START_TEST(test_all_bytes_all_keys)
+{
+    char text[600];
+    
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+        text[i] = (char)(1 + (i * 7) % 255);
+    text[sizeof(text) - 1] = '\0';
+    
+    for (int key = -30; key <= 30; key++)
+    {
+        for (size_t start = 0; start < 70; start += 23)
+        {
+            char* result = NULL;
+            
+            ck_assert_int_eq(encrypt_caesar(text + start, key, &result), CRYPTO_SUCCESS);
+            
+            for (size_t i = 0; text[start + i]; i++)
+            {
+                unsigned char c = (unsigned char)text[start + i];
+                unsigned char expected = c;
+                int k = ((key % 26) + 26) % 26;
+                
+                if (c >= 'A' && c <= 'Z')
+                    expected = (unsigned char)('A' + (c - 'A' + k) % 26);
+                else if (c >= 'a' && c <= 'z')
+                    expected = (unsigned char)('a' + (c - 'a' + k) % 26);
+                
+                ck_assert_uint_eq((unsigned char)result[i], expected);
+            }
+            
+            free(result);
+        }
+    }
+} 
+END_TEST
+
+START_TEST(test_iov_matches_oneshot)
+{
+    char text[] = "Attack at dawn, hold the line! Zebra xylophone.";
+    char segmented[sizeof(text)];
+    char* expected = NULL;
+    size_t len = strlen(text);
+    
+    ck_assert_int_eq(encrypt_caesar(text, -7, &expected), CRYPTO_SUCCESS);
+    
+    struct iovec input[] = {
+        { text, 5 }, { text + 5, 0 }, { text + 5, 13 }, { text + 18, len - 18 }
+    };
+    struct iovec output[] = {
+        { segmented, 1 }, { segmented + 1, 20 }, { segmented + 21, len - 21 }
+    };
+    
+    ck_assert_int_eq(encrypt_caesar_iov(input, 4, output, 3, -7), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, expected, len);
+    
+    struct iovec in_place[] = {
+        { segmented, 7 }, { segmented + 7, len - 7 }
+    };
+    
+    ck_assert_int_eq(decrypt_caesar_iov(in_place, 2, in_place, 2, -7), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, text, len);
+    
+    ck_assert_int_eq(encrypt_caesar_iov(input, 4, output, 2, -7), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(encrypt_caesar_iov(NULL, 1, output, 3, -7), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+} 
+END_TEST
+
+START_TEST(test_stream_matches_oneshot)
+{
+    char text[600];
+    char streamed[sizeof(text)];
+    char* expected = NULL;
+    
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+        text[i] = (char)(1 + (i * 11) % 255);
+    text[sizeof(text) - 1] = '\0';
+    
+    size_t len = strlen(text);
+    ck_assert_int_eq(encrypt_caesar(text, 29, &expected), CRYPTO_SUCCESS);
+    
+    struct caesar_stream_ctx ctx;
+    ck_assert_int_eq(caesar_stream_init(&ctx, 29, 0), CRYPTO_SUCCESS);
+    
+    for (size_t offset = 0, chunk = 0; offset < len; offset += chunk)
+    {
+        chunk = (offset % 7) * 13 + 1;
+        if (chunk > len - offset)
+            chunk = len - offset;
+        
+        ck_assert_int_eq(caesar_stream_update(&ctx, text + offset, chunk, streamed + offset), CRYPTO_SUCCESS);
+    }
+    
+    ck_assert_int_eq(caesar_stream_final(&ctx), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(streamed, expected, len);
+    
+    ck_assert_int_eq(caesar_stream_init(&ctx, 29, 1), CRYPTO_SUCCESS);
+    ck_assert_int_eq(caesar_stream_update(&ctx, streamed, len, streamed), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(streamed, text, len);
+    
+    ck_assert_int_eq(caesar_stream_init(NULL, 29, 0), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+} 
+END_TEST
+
+START_TEST(test_crack)
+{
+    const char* text = "It was the best of times, it was the worst of times, "
+        "it was the age of wisdom, it was the age of foolishness.";
+    struct crack_candidate ranked[26];
+    char* cipher = NULL;
+    
+    ck_assert_int_eq(encrypt_caesar(text, 7, &cipher), CRYPTO_SUCCESS);
+    ck_assert_int_eq(crack_caesar(cipher, NULL, ranked), CRYPTO_SUCCESS);
+    ck_assert_int_eq(ranked[0].key, 7);
+    
+    for (int i = 1; i < 26; i++)
+        ck_assert(ranked[i - 1].score <= ranked[i].score);
+    
+    double model[26];
+    for (int i = 0; i < 26; i++)
+        model[i] = 1.0;
+    model[4] = 0.0;
+    
+    ck_assert_int_eq(crack_caesar(cipher, model, ranked), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(crack_caesar("1234 !?", NULL, ranked), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(crack_caesar(NULL, NULL, ranked), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(cipher);
+} 
+END_TEST
+
+START_TEST(test_crack_batch)
+{
+    const char* lines[] = {
+        "the quick brown fox jumps over the lazy dog near the river bank",
+        "meet me at the usual place at ten tonight and bring the documents",
+        "there is nothing either good or bad but thinking makes it so"
+    };
+    enum { COUNT = 3000 };
+    char** ciphers = (char**)malloc(COUNT * sizeof(char*));
+    int* keys = (int*)malloc(COUNT * sizeof(int));
+    
+    ck_assert_ptr_nonnull(ciphers);
+    ck_assert_ptr_nonnull(keys);
+    
+    for (int i = 0; i < COUNT; i++)
+        ck_assert_int_eq(encrypt_caesar(lines[i % 3], i % 26, &ciphers[i]), CRYPTO_SUCCESS);
+    
+    free(ciphers[COUNT - 1]);
+    ck_assert_int_eq(encrypt_caesar("--", 0, &ciphers[COUNT - 1]), CRYPTO_SUCCESS);
+    
+    ck_assert_int_eq(crack_caesar_batch((const char* const*)ciphers, COUNT, NULL, 4, keys), CRYPTO_SUCCESS);
+    
+    for (int i = 0; i < COUNT - 1; i++)
+        ck_assert_int_eq(keys[i], i % 26);
+    ck_assert_int_eq(keys[COUNT - 1], -1);
+    
+    for (int i = 0; i < COUNT; i++)
+        free(ciphers[i]);
+    free(ciphers);
+    free(keys);
+} 
+END_TEST
+
 Suite* caesar_suite(void)
 {
     Suite* s;
@@ -136,6 +304,11 @@ Suite* caesar_suite(void)
     tcase_add_test(tc_core, test_non_letters);
     tcase_add_test(tc_core, test_null_input);
     tcase_add_test(tc_core, test_case_preservation);
+    tcase_add_test(tc_core, test_all_bytes_all_keys);
+    tcase_add_test(tc_core, test_iov_matches_oneshot);
+    tcase_add_test(tc_core, test_stream_matches_oneshot);
+    tcase_add_test(tc_core, test_crack);
+    tcase_add_test(tc_core, test_crack_batch);
     
     suite_add_tcase(s, tc_core);
     
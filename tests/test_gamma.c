@@ -1,7 +1,9 @@
 #include <check.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include "crypto/gamma.h"
+#include "crypto/vernam.h"
 #include "crypto/core.h"
 
 START_TEST(test_encrypt_decrypt_basic)
@@ -176,6 +178,753 @@ START_TEST(test_zero_length)
 } 
 END_TEST
 
+START_TEST(test_known_vector)
+{
+    unsigned char* encrypted = NULL;
+    enum crypto_status status;
+    
+    unsigned char data[] = "HELLO";
+    unsigned char expected[] = {0x38, 0x38, 0xAC, 0xD8, 0xBA};
+    
+    status = encrypt_gamma(data, 5, 12345, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    ck_assert_mem_eq(encrypted, expected, 5);
+    
+    free(encrypted);
+} 
+END_TEST
+
+START_TEST(test_multi_block_vector)
+{
+    unsigned char* encrypted = NULL;
+    enum crypto_status status;
+    
+    unsigned char data[70];
+    unsigned char expected[70] = {
+        0xCF, 0xE7, 0x09, 0x17, 0x97, 0x63, 0x4F, 0x67, 0xCE, 0x14,
+        0xFF, 0x74, 0x97, 0x86, 0xC4, 0x50, 0x3D, 0x0E, 0x22, 0xC8,
+        0xCE, 0x2D, 0x25, 0xD3, 0x81, 0x52, 0xA3, 0xA6, 0xFB, 0x17,
+        0x94, 0x52, 0x38, 0x1A, 0x6C, 0x12, 0x3F, 0x6B, 0x5B, 0xDB,
+        0x6E, 0x65, 0x6C, 0x51, 0x55, 0xBE, 0x06, 0x16, 0xB3, 0x51,
+        0xE0, 0xA3, 0xE7, 0xDD, 0x30, 0x9D, 0x0B, 0x35, 0x21, 0xD4,
+        0x86, 0x58, 0x21, 0xB3, 0x61, 0x05, 0xD4, 0x51, 0xB3, 0x92
+    };
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)i;
+    
+    status = encrypt_gamma(data, sizeof(data), 777, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    ck_assert_mem_eq(encrypted, expected, sizeof(data));
+    
+    free(encrypted);
+} 
+END_TEST
+
+START_TEST(test_large_buffer)
+{
+    unsigned char* encrypted = NULL;
+    unsigned char* decrypted = NULL;
+    enum crypto_status status;
+    
+    size_t len = 4 * 1024 * 1024;
+    unsigned char* data = (unsigned char*)malloc(len);
+    ck_assert_ptr_nonnull(data);
+    
+    for (size_t i = 0; i < len; i++)
+        data[i] = (unsigned char)(i * 31);
+    
+    status = encrypt_gamma(data, len, 4242, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = decrypt_gamma(encrypted, len, 4242, &decrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    ck_assert_mem_eq(decrypted, data, len);
+    
+    free(data);
+    free(encrypted);
+    free(decrypted);
+} 
+END_TEST
+
+START_TEST(test_stream_matches_oneshot)
+{
+    unsigned char* expected = NULL;
+    struct gamma_stream_ctx ctx;
+    enum crypto_status status;
+    
+    size_t len = 1000;
+    unsigned char data[1000];
+    unsigned char output[1000];
+    size_t chunks[] = {1, 7, 64, 65, 200, 3, 660};
+    
+    for (size_t i = 0; i < len; i++)
+        data[i] = (unsigned char)(i * 7 + 3);
+    
+    status = encrypt_gamma(data, len, 31337, &expected);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = gamma_stream_init(&ctx, 31337, len);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    size_t pos = 0;
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++)
+    {
+        status = gamma_stream_update(&ctx, data + pos, chunks[i], output + pos);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        pos += chunks[i];
+    }
+    
+    ck_assert_int_eq(pos, len);
+    ck_assert_int_eq(gamma_stream_final(&ctx), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(output, expected, len);
+    
+    free(expected);
+} 
+END_TEST
+
+START_TEST(test_stream_length_mismatch)
+{
+    struct gamma_stream_ctx ctx;
+    unsigned char data[16] = {0};
+    unsigned char output[16];
+    enum crypto_status status;
+    
+    status = gamma_stream_init(&ctx, 1, 0);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    status = gamma_stream_init(&ctx, 1, 10);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = gamma_stream_update(&ctx, data, 16, output);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    status = gamma_stream_update(&ctx, data, 4, output);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = gamma_stream_final(&ctx);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+} 
+END_TEST
+
+START_TEST(test_ctx_matches_oneshot)
+{
+    unsigned char* expected = NULL;
+    unsigned char* encrypted = NULL;
+    unsigned char* decrypted = NULL;
+    struct gamma_ctx ctx;
+    enum crypto_status status;
+    
+    unsigned char data[] = "The quick brown fox";
+    size_t len = strlen((char*)data);
+    
+    status = encrypt_gamma(data, len, 2024, &expected);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    ck_assert_int_eq(gamma_ctx_init(&ctx, 2024), CRYPTO_SUCCESS);
+    status = encrypt_gamma_ctx(&ctx, data, len, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_mem_eq(encrypted, expected, len);
+    
+    ck_assert_int_eq(gamma_ctx_init(&ctx, 2024), CRYPTO_SUCCESS);
+    status = decrypt_gamma_ctx(&ctx, encrypted, len, &decrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_mem_eq(decrypted, data, len);
+    
+    free(expected);
+    free(encrypted);
+    free(decrypted);
+} 
+END_TEST
+
+START_TEST(test_ctx_continues_sequence)
+{
+    unsigned char* first = NULL;
+    unsigned char* second = NULL;
+    struct gamma_ctx ctx;
+    enum crypto_status status;
+    
+    unsigned char data[] = "SAME";
+    
+    gamma_ctx_init(&ctx, 99);
+    
+    status = encrypt_gamma_ctx(&ctx, data, 4, &first);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = encrypt_gamma_ctx(&ctx, data, 4, &second);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    ck_assert_mem_ne(first, second, 4);
+    
+    free(first);
+    free(second);
+} 
+END_TEST
+
+struct gamma_thread_job {
+    uint32_t seed;
+    const unsigned char* data;
+    size_t len;
+    const unsigned char* expected;
+    int mismatches;
+};
+
+static void* gamma_thread(void* arg)
+{
+    struct gamma_thread_job* job = (struct gamma_thread_job*)arg;
+    
+    for (int i = 0; i < 200; i++)
+    {
+        unsigned char* encrypted = NULL;
+        
+        if (encrypt_gamma(job->data, job->len, job->seed, &encrypted) != CRYPTO_SUCCESS ||
+            memcmp(encrypted, job->expected, job->len) != 0)
+            job->mismatches++;
+        
+        free(encrypted);
+    }
+    
+    return NULL;
+}
+
+START_TEST(test_concurrent_calls)
+{
+    pthread_t threads[4];
+    struct gamma_thread_job jobs[4];
+    unsigned char* expected[4];
+    
+    unsigned char data[] = "Concurrent gamma calls must not share PRNG state";
+    size_t len = strlen((char*)data);
+    
+    for (int i = 0; i < 4; i++)
+    {
+        ck_assert_int_eq(encrypt_gamma(data, len, 1000 + i, &expected[i]), CRYPTO_SUCCESS);
+        jobs[i] = (struct gamma_thread_job){ 1000 + i, data, len, expected[i], 0 };
+        ck_assert_int_eq(pthread_create(&threads[i], NULL, gamma_thread, &jobs[i]), 0);
+    }
+    
+    for (int i = 0; i < 4; i++)
+    {
+        pthread_join(threads[i], NULL);
+        ck_assert_int_eq(jobs[i].mismatches, 0);
+        free(expected[i]);
+    }
+} 
+END_TEST
+
+START_TEST(test_range_matches_full)
+{
+    unsigned char* encrypted = NULL;
+    enum crypto_status status;
+    
+    size_t len = 300000;
+    size_t offsets[] = {0, 1, 63, 4096, 150001, 299990};
+    size_t lengths[] = {10, 100, 1, 70000, 5, 10};
+    unsigned char* data = (unsigned char*)malloc(len);
+    ck_assert_ptr_nonnull(data);
+    
+    for (size_t i = 0; i < len; i++)
+        data[i] = (unsigned char)(i * 13 + 5);
+    
+    status = encrypt_gamma(data, len, 8675309, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++)
+    {
+        unsigned char* part = NULL;
+        
+        status = decrypt_gamma_range(encrypted, len, 8675309, offsets[i], lengths[i], &part);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(part, data + offsets[i], lengths[i]);
+        
+        free(part);
+    }
+    
+    free(data);
+    free(encrypted);
+} 
+END_TEST
+
+START_TEST(test_range_invalid)
+{
+    unsigned char* result = NULL;
+    unsigned char data[] = "TEST";
+    enum crypto_status status;
+    
+    status = decrypt_gamma_range(data, 4, 1, 3, 2, &result);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    status = decrypt_gamma_range(data, 4, 1, 5, 1, &result);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    status = decrypt_gamma_range(data, 4, 1, 0, 0, &result);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    status = decrypt_gamma_range(NULL, 4, 1, 0, 1, &result);
+    ck_assert_int_eq(status, CRYPTO_ERROR_NULL_POINTER);
+} 
+END_TEST
+
+START_TEST(test_ctx_skip)
+{
+    unsigned char* first = NULL;
+    unsigned char* second = NULL;
+    struct gamma_ctx walked;
+    struct gamma_ctx skipped;
+    
+    size_t len = 1000;
+    unsigned char data[1000] = {0};
+    
+    gamma_ctx_init(&walked, 4321);
+    ck_assert_int_eq(encrypt_gamma_ctx(&walked, data, len, &first), CRYPTO_SUCCESS);
+    free(first);
+    
+    gamma_ctx_init(&skipped, 4321);
+    ck_assert_int_eq(gamma_ctx_skip(&skipped, 8 * len), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(skipped.state, walked.state);
+    
+    ck_assert_int_eq(encrypt_gamma_ctx(&walked, data, len, &first), CRYPTO_SUCCESS);
+    ck_assert_int_eq(encrypt_gamma_ctx(&skipped, data, len, &second), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(first, second, len);
+    
+    free(first);
+    free(second);
+} 
+END_TEST
+
+START_TEST(test_parallel_matches_serial)
+{
+    unsigned char* expected = NULL;
+    unsigned char* encrypted = NULL;
+    unsigned char* decrypted = NULL;
+    enum crypto_status status;
+    
+    size_t len = 1000003;
+    size_t threads[] = {0, 1, 3, 8};
+    unsigned char* data = (unsigned char*)malloc(len);
+    ck_assert_ptr_nonnull(data);
+    
+    for (size_t i = 0; i < len; i++)
+        data[i] = (unsigned char)(i ^ (i >> 8));
+    
+    status = encrypt_gamma(data, len, 777, &expected);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        status = encrypt_gamma_parallel(data, len, 777, threads[i], &encrypted);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(encrypted, expected, len);
+        
+        status = decrypt_gamma_parallel(encrypted, len, 777, threads[i], &decrypted);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(decrypted, data, len);
+        
+        free(encrypted);
+        free(decrypted);
+    }
+    
+    free(data);
+    free(expected);
+} 
+END_TEST
+
+START_TEST(test_parallel_small_input)
+{
+    unsigned char* expected = NULL;
+    unsigned char* encrypted = NULL;
+    enum crypto_status status;
+    
+    unsigned char data[] = "HELLO";
+    
+    status = encrypt_gamma(data, 5, 12345, &expected);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = encrypt_gamma_parallel(data, 5, 12345, 16, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_mem_eq(encrypted, expected, 5);
+    
+    status = encrypt_gamma_parallel(data, 0, 12345, 16, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    free(expected);
+    free(encrypted);
+} 
+END_TEST
+
+START_TEST(test_batch_matches_single)
+{
+    enum crypto_status status;
+    
+    size_t count = 37;
+    const unsigned char* inputs[37];
+    unsigned char* outputs[37];
+    unsigned char* restored[37];
+    size_t lengths[37];
+    uint32_t seeds[37];
+    unsigned char data[300];
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i * 11);
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        inputs[i] = data + i;
+        lengths[i] = 1 + (i * 37) % 256;
+        seeds[i] = (uint32_t)(i * 2654435761U);
+    }
+    
+    status = encrypt_gamma_batch(inputs, lengths, seeds, count, outputs);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        unsigned char* expected = NULL;
+        
+        status = encrypt_gamma(inputs[i], lengths[i], seeds[i], &expected);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(outputs[i], expected, lengths[i]);
+        
+        free(expected);
+    }
+    
+    status = decrypt_gamma_batch((const unsigned char* const*)outputs, lengths, seeds, count, restored);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        ck_assert_mem_eq(restored[i], inputs[i], lengths[i]);
+        free(outputs[i]);
+        free(restored[i]);
+    }
+} 
+END_TEST
+
+START_TEST(test_batch_invalid)
+{
+    unsigned char data[] = "TEST";
+    const unsigned char* inputs[2] = { data, NULL };
+    unsigned char* outputs[2];
+    size_t lengths[2] = { 4, 4 };
+    uint32_t seeds[2] = { 1, 2 };
+    enum crypto_status status;
+    
+    status = encrypt_gamma_batch(inputs, lengths, seeds, 2, outputs);
+    ck_assert_int_eq(status, CRYPTO_ERROR_NULL_POINTER);
+    
+    inputs[1] = data;
+    lengths[1] = 0;
+    status = encrypt_gamma_batch(inputs, lengths, seeds, 2, outputs);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    status = encrypt_gamma_batch(inputs, lengths, seeds, 0, outputs);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+} 
+END_TEST
+
+START_TEST(test_generators_roundtrip)
+{
+    enum gamma_generator generators[] = {
+        GAMMA_GEN_XORSHIFT32, GAMMA_GEN_XOSHIRO256SS, GAMMA_GEN_CHACHA20, GAMMA_GEN_AES_CTR
+    };
+    enum crypto_status status;
+    
+    size_t len = 5000;
+    unsigned char data[5000];
+    
+    for (size_t i = 0; i < len; i++)
+        data[i] = (unsigned char)(i * 3);
+    
+    for (size_t g = 0; g < 4; g++)
+    {
+        unsigned char* encrypted = NULL;
+        unsigned char* decrypted = NULL;
+        
+        status = encrypt_gamma_gen(data, len, 2026, generators[g], &encrypted);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_ne(encrypted, data, len);
+        
+        status = decrypt_gamma_gen(encrypted, len, 2026, generators[g], &decrypted);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(decrypted, data, len);
+        
+        free(encrypted);
+        free(decrypted);
+    }
+} 
+END_TEST
+
+START_TEST(test_generators_known_vectors)
+{
+    unsigned char data[8] = {0};
+    unsigned char expected[3][8] = {
+        {0xA2, 0x37, 0x9F, 0x7C, 0xC1, 0x54, 0x42, 0x02},
+        {0xD4, 0x70, 0x7D, 0xCC, 0x53, 0x2C, 0x39, 0x5A},
+        {0xFB, 0x2C, 0xFF, 0x85, 0xDF, 0x95, 0x3A, 0xC9}
+    };
+    enum gamma_generator generators[] = {
+        GAMMA_GEN_XOSHIRO256SS, GAMMA_GEN_CHACHA20, GAMMA_GEN_AES_CTR
+    };
+    unsigned char* encrypted = NULL;
+    unsigned char* classic = NULL;
+    
+    for (size_t g = 0; g < 3; g++)
+    {
+        ck_assert_int_eq(encrypt_gamma_gen(data, 8, 42, generators[g], &encrypted), CRYPTO_SUCCESS);
+        ck_assert_mem_eq(encrypted, expected[g], 8);
+        free(encrypted);
+    }
+    
+    ck_assert_int_eq(encrypt_gamma_gen(data, 8, 42, GAMMA_GEN_XORSHIFT32, &encrypted), CRYPTO_SUCCESS);
+    ck_assert_int_eq(encrypt_gamma(data, 8, 42, &classic), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(encrypted, classic, 8);
+    
+    free(encrypted);
+    free(classic);
+    
+    ck_assert_int_eq(encrypt_gamma_gen(data, 8, 42, (enum gamma_generator)99, &encrypted),
+                     CRYPTO_ERROR_INVALID_KEY);
+} 
+END_TEST
+
+START_TEST(test_cache_hits_and_output)
+{
+    struct gamma_cache* cache = NULL;
+    struct gamma_cache_stats stats;
+    enum crypto_status status;
+    
+    unsigned char data[200];
+    size_t lengths[] = {10, 64, 50, 200, 130};
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i + 1);
+    
+    ck_assert_int_eq(gamma_cache_create(1 << 20, &cache), CRYPTO_SUCCESS);
+    
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        unsigned char* expected = NULL;
+        unsigned char* encrypted = NULL;
+        unsigned char* decrypted = NULL;
+        
+        ck_assert_int_eq(encrypt_gamma(data, lengths[i], 555, &expected), CRYPTO_SUCCESS);
+        
+        status = encrypt_gamma_cached(cache, data, lengths[i], 555, &encrypted);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(encrypted, expected, lengths[i]);
+        
+        status = decrypt_gamma_cached(cache, encrypted, lengths[i], 555, &decrypted);
+        ck_assert_int_eq(status, CRYPTO_SUCCESS);
+        ck_assert_mem_eq(decrypted, data, lengths[i]);
+        
+        free(expected);
+        free(encrypted);
+        free(decrypted);
+    }
+    
+    ck_assert_int_eq(gamma_cache_get_stats(cache, &stats), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(stats.misses, 2);
+    ck_assert_uint_eq(stats.hits, 8);
+    ck_assert_uint_eq(stats.entries, 2);
+    ck_assert_uint_eq(stats.evictions, 0);
+    
+    gamma_cache_free(cache);
+} 
+END_TEST
+
+START_TEST(test_cache_memory_cap)
+{
+    struct gamma_cache* cache = NULL;
+    struct gamma_cache_stats stats;
+    unsigned char* encrypted = NULL;
+    
+    unsigned char data[1000] = {0};
+    
+    ck_assert_int_eq(gamma_cache_create(4096, &cache), CRYPTO_SUCCESS);
+    
+    for (uint32_t seed = 1; seed <= 20; seed++)
+    {
+        ck_assert_int_eq(encrypt_gamma_cached(cache, data, 1000, seed, &encrypted), CRYPTO_SUCCESS);
+        free(encrypted);
+        
+        gamma_cache_get_stats(cache, &stats);
+        ck_assert_uint_le(stats.bytes, stats.max_bytes);
+    }
+    
+    ck_assert_uint_gt(stats.evictions, 0);
+    ck_assert_uint_eq(stats.misses, 20);
+    
+    ck_assert_int_eq(encrypt_gamma_cached(cache, data, 1000, 20, &encrypted), CRYPTO_SUCCESS);
+    free(encrypted);
+    
+    gamma_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.hits, 1);
+    
+    gamma_cache_free(cache);
+} 
+END_TEST
+
+START_TEST(test_direct_mode)
+{
+    unsigned char* encrypted = NULL;
+    unsigned char* decrypted = NULL;
+    unsigned char* classic = NULL;
+    enum crypto_status status;
+    
+    unsigned char zeros[6] = {0};
+    unsigned char expected[4] = {0x21, 0x20, 0x04, 0x00};
+    unsigned char data[] = "Direct mode keeps the seed semantics";
+    size_t len = strlen((char*)data);
+    
+    status = encrypt_gamma_mode(zeros, 6, 1, GAMMA_MODE_DIRECT, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_mem_eq(encrypted, expected, 4);
+    free(encrypted);
+    
+    status = encrypt_gamma_mode(data, len, 77, GAMMA_MODE_DIRECT, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_mem_ne(encrypted, data, len);
+    
+    status = decrypt_gamma_mode(encrypted, len, 77, GAMMA_MODE_DIRECT, &decrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_mem_eq(decrypted, data, len);
+    
+    free(encrypted);
+    free(decrypted);
+    
+    status = encrypt_gamma_mode(data, len, 77, GAMMA_MODE_CLASSIC, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_int_eq(encrypt_gamma(data, len, 77, &classic), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(encrypted, classic, len);
+    
+    free(encrypted);
+    free(classic);
+    
+    status = encrypt_gamma_mode(data, len, 77, (enum gamma_mode)5, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+} 
+END_TEST
+
+START_TEST(test_recover_seed)
+{
+    unsigned char* encrypted = NULL;
+    uint32_t seeds[4];
+    uint64_t count = 0;
+    enum crypto_status status;
+    
+    unsigned char data[] = "Incident report: the quick brown fox was seen at dawn";
+    size_t len = strlen((char*)data);
+    
+    status = encrypt_gamma(data, len, 0xC0FFEE42, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = gamma_recover_seed(encrypted, len, data + 17, 8, 17, seeds, 4, &count);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_uint_eq(count, 1);
+    ck_assert_uint_eq(seeds[0], 0xC0FFEE42);
+    
+    status = gamma_recover_seed(encrypted, len, (const unsigned char*)"XXXXXXXX", 8, 17, seeds, 4, &count);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_uint_eq(count, 0);
+    
+    free(encrypted);
+    
+    status = encrypt_gamma(data, len, 0, &encrypted);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    status = gamma_recover_seed(encrypted, len, data, 8, 0, seeds, 4, &count);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_uint_eq(count, 2);
+    ck_assert_uint_eq(seeds[0], 2463534242U);
+    ck_assert_uint_eq(seeds[1], 0);
+    
+    status = gamma_recover_seed(encrypted, len, data, 8, len - 4, seeds, 4, &count);
+    ck_assert_int_eq(status, CRYPTO_ERROR_INVALID_INPUT);
+    
+    free(encrypted);
+} 
+END_TEST
+
+START_TEST(test_iov_matches_oneshot)
+{
+    unsigned char data[100];
+    unsigned char segmented[100];
+    unsigned char* expected = NULL;
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i * 5);
+    
+    ck_assert_int_eq(encrypt_gamma(data, 90, 4242, &expected), CRYPTO_SUCCESS);
+    
+    struct iovec input[] = {
+        { data, 33 }, { data + 33, 0 }, { data + 33, 57 }
+    };
+    struct iovec output[] = {
+        { segmented, 1 }, { segmented + 1, 64 }, { segmented + 65, 25 }
+    };
+    
+    ck_assert_int_eq(encrypt_gamma_iov(input, 3, output, 3, 4242), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, expected, 90);
+    
+    ck_assert_int_eq(decrypt_gamma_iov(output, 3, output, 3, 4242), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, data, 90);
+    
+    ck_assert_int_eq(encrypt_gamma_iov(input, 3, output, 2, 4242), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(encrypt_gamma_iov(input, 0, output, 0, 4242), CRYPTO_ERROR_INVALID_INPUT);
+    
+    free(expected);
+} 
+END_TEST
+
+START_TEST(test_streaming_stores)
+{
+    static unsigned char data[10007];
+    static unsigned char streamed[2][sizeof(data)];
+    unsigned char* classic[2] = { NULL, NULL };
+    unsigned char* direct[2] = { NULL, NULL };
+    size_t saved = vernam_get_stream_threshold();
+    const size_t thresholds[2] = { SIZE_MAX, 0 };
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i * 31 + 7);
+    
+    for (int t = 0; t < 2; t++)
+    {
+        struct gamma_stream_ctx ctx;
+        
+        vernam_set_stream_threshold(thresholds[t]);
+        ck_assert_int_eq(encrypt_gamma(data, sizeof(data), 4242, &classic[t]), CRYPTO_SUCCESS);
+        ck_assert_int_eq(encrypt_gamma_mode(data, sizeof(data), 4242, GAMMA_MODE_DIRECT, &direct[t]), CRYPTO_SUCCESS);
+        
+        ck_assert_int_eq(gamma_stream_init(&ctx, 4242, sizeof(data)), CRYPTO_SUCCESS);
+        for (size_t offset = 0, chunk = 0; offset < sizeof(data); offset += chunk)
+        {
+            chunk = offset % 5000 + 1;
+            if (chunk > sizeof(data) - offset)
+                chunk = sizeof(data) - offset;
+            ck_assert_int_eq(gamma_stream_update(&ctx, data + offset, chunk, streamed[t] + offset), CRYPTO_SUCCESS);
+        }
+        ck_assert_int_eq(gamma_stream_final(&ctx), CRYPTO_SUCCESS);
+    }
+    
+    vernam_set_stream_threshold(saved);
+    
+    ck_assert_mem_eq(classic[1], classic[0], sizeof(data));
+    ck_assert_mem_eq(direct[1], direct[0], sizeof(data));
+    ck_assert_mem_eq(streamed[0], classic[0], sizeof(data));
+    ck_assert_mem_eq(streamed[1], classic[0], sizeof(data));
+    
+    for (int t = 0; t < 2; t++)
+    {
+        free(classic[t]);
+        free(direct[t]);
+    }
+} 
+END_TEST
+
 Suite* gamma_suite(void)
 {
     Suite* s;
@@ -192,6 +941,29 @@ Suite* gamma_suite(void)
     tcase_add_test(tc_core, test_wrong_seed);
     tcase_add_test(tc_core, test_null_input);
     tcase_add_test(tc_core, test_zero_length);
+    tcase_add_test(tc_core, test_known_vector);
+    tcase_add_test(tc_core, test_multi_block_vector);
+    tcase_add_test(tc_core, test_large_buffer);
+    tcase_add_test(tc_core, test_stream_matches_oneshot);
+    tcase_add_test(tc_core, test_stream_length_mismatch);
+    tcase_add_test(tc_core, test_ctx_matches_oneshot);
+    tcase_add_test(tc_core, test_ctx_continues_sequence);
+    tcase_add_test(tc_core, test_concurrent_calls);
+    tcase_add_test(tc_core, test_range_matches_full);
+    tcase_add_test(tc_core, test_range_invalid);
+    tcase_add_test(tc_core, test_ctx_skip);
+    tcase_add_test(tc_core, test_parallel_matches_serial);
+    tcase_add_test(tc_core, test_parallel_small_input);
+    tcase_add_test(tc_core, test_batch_matches_single);
+    tcase_add_test(tc_core, test_batch_invalid);
+    tcase_add_test(tc_core, test_generators_roundtrip);
+    tcase_add_test(tc_core, test_generators_known_vectors);
+    tcase_add_test(tc_core, test_cache_hits_and_output);
+    tcase_add_test(tc_core, test_cache_memory_cap);
+    tcase_add_test(tc_core, test_direct_mode);
+    tcase_add_test(tc_core, test_recover_seed);
+    tcase_add_test(tc_core, test_iov_matches_oneshot);
+    tcase_add_test(tc_core, test_streaming_stores);
     
     suite_add_tcase(s, tc_core);
     
@@ -155,6 +155,87 @@ START_TEST(test_null_input)
 } 
 END_TEST
 
+/**
+ * @brief Test long inputs crossing vector boundaries
+ */
+START_TEST(test_long_input)
+{
+    char text[256];
+    char digits[1001];
+    char* result = NULL;
+    
+    for (int c = 1; c < 256; c++)
+        text[c - 1] = (char)c;
+    text[255] = '\0';
+    
+    ck_assert_int_eq(encrypt_polybius(text, &result), CRYPTO_SUCCESS);
+    ck_assert_str_eq(result,
+        "1112131415212223242425313233343541424344455152535455"
+        "1112131415212223242425313233343541424344455152535455");
+    free(result);
+    
+    for (size_t i = 0; i < 1000; i += 2)
+    {
+        digits[i] = (char)('1' + (i / 2) % 5);
+        digits[i + 1] = (char)('1' + (i / 10) % 5);
+    }
+    digits[1000] = '\0';
+    
+    ck_assert_int_eq(decrypt_polybius(digits, &result), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(strlen(result), 500);
+    
+    for (size_t i = 0; i < 500; i++)
+    {
+        int index = (int)(i % 5) * 5 + (int)(i / 5) % 5;
+        ck_assert_int_eq(result[i], "ABCDEFGHIKLMNOPQRSTUVWXYZ"[index]);
+    }
+    free(result);
+    
+    digits[777] = '6';
+    ck_assert_int_eq(decrypt_polybius(digits, &result), CRYPTO_ERROR_INVALID_INPUT);
+} 
+END_TEST
+
+/**
+ * @brief Test keyed square context
+ */
+START_TEST(test_keyed_square)
+{
+    struct polybius_ctx ctx;
+    char* result = NULL;
+    
+    ck_assert_int_eq(polybius_ctx_init(&ctx, "Keyword"), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(ctx.decode, "KEYWORDABCFGHILMNPQSTUVXZ", 25);
+    
+    ck_assert_int_eq(encrypt_polybius_ctx(&ctx, "key, word: z!", &result), CRYPTO_SUCCESS);
+    ck_assert_str_eq(result, "11121314152122" "55");
+    free(result);
+    
+    ck_assert_int_eq(decrypt_polybius_ctx(&ctx, "1112131415212255", &result), CRYPTO_SUCCESS);
+    ck_assert_str_eq(result, "KEYWORDZ");
+    free(result);
+    
+    ck_assert_int_eq(polybius_ctx_init(&ctx, "jam"), CRYPTO_SUCCESS);
+    ck_assert_int_eq(encrypt_polybius_ctx(&ctx, "JIMA", &result), CRYPTO_SUCCESS);
+    ck_assert_str_eq(result, "11111312");
+    free(result);
+    
+    const char* text = "The quick brown fox jumps over the lazy dog, again and again and again";
+    char* expected = NULL;
+    
+    ck_assert_int_eq(polybius_ctx_init(&ctx, NULL), CRYPTO_SUCCESS);
+    ck_assert_int_eq(encrypt_polybius(text, &expected), CRYPTO_SUCCESS);
+    ck_assert_int_eq(encrypt_polybius_ctx(&ctx, text, &result), CRYPTO_SUCCESS);
+    ck_assert_str_eq(result, expected);
+    free(result);
+    free(expected);
+    
+    ck_assert_int_eq(polybius_ctx_init(&ctx, "key1"), CRYPTO_ERROR_INVALID_KEY);
+    ck_assert_int_eq(polybius_ctx_init(NULL, "key"), CRYPTO_ERROR_NULL_POINTER);
+    ck_assert_int_eq(encrypt_polybius_ctx(NULL, text, &result), CRYPTO_ERROR_NULL_POINTER);
+} 
+END_TEST
+
 /**
  * @brief Create test suite
  */
@@ -174,6 +255,8 @@ Suite* polybius_suite(void)
     tcase_add_test(tc_core, test_odd_length);
     tcase_add_test(tc_core, test_invalid_digits);
     tcase_add_test(tc_core, test_null_input);
+    tcase_add_test(tc_core, test_long_input);
+    tcase_add_test(tc_core, test_keyed_square);
     
     suite_add_tcase(s, tc_core);
     
@@ -7,8 +7,12 @@
  */
 
 #include <check.h>
+#include <limits.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "crypto/trithemius.h"
+#include "crypto/crack.h"
 #include "crypto/core.h"
 
 /**
@@ -119,6 +123,44 @@ START_TEST(test_negative_key)
 } 
 END_TEST
 
+/**
+ * @brief Test INT_MAX/INT_MIN keys round-trip
+ */
+START_TEST(test_extreme_keys)
+{
+    char* result = NULL;
+    char* restored = NULL;
+    enum crypto_status status;
+    
+    status = encrypt_trithemius("AAAA", INT_MAX, &result);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_str_eq(result, "XYZA");
+    free(result);
+    
+    status = encrypt_trithemius("AAAA", INT_MIN, &result);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_str_eq(result, "CDEF");
+    free(result);
+    
+    char text[1001];
+    memset(text, 'A', 1000);
+    text[1000] = '\0';
+    
+    status = encrypt_trithemius(text, INT_MAX, &result);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    
+    for (int i = 0; i < 1000; i++)
+        ck_assert_int_eq(result[i], 'A' + (INT_MAX % 26 + i) % 26);
+    
+    status = decrypt_trithemius(result, INT_MAX, &restored);
+    ck_assert_int_eq(status, CRYPTO_SUCCESS);
+    ck_assert_str_eq(restored, text);
+    
+    free(result);
+    free(restored);
+} 
+END_TEST
+
 /**
  * @brief Test NULL input handling
  */
@@ -153,6 +195,267 @@ START_TEST(test_case_preservation)
 } 
 END_TEST
 
+/**
+ * @brief Test scatter/gather variant against one-shot call
+ */
+START_TEST(test_iov_matches_oneshot)
+{
+    char text[] = "Attack at dawn, hold the line! Zebra xylophone.";
+    char segmented[sizeof(text)];
+    char* expected = NULL;
+    size_t len = strlen(text);
+    
+    ck_assert_int_eq(encrypt_trithemius(text, 5, &expected), CRYPTO_SUCCESS);
+    
+    struct iovec input[] = {
+        { text, 5 }, { text + 5, 0 }, { text + 5, 13 }, { text + 18, len - 18 }
+    };
+    struct iovec output[] = {
+        { segmented, 1 }, { segmented + 1, 20 }, { segmented + 21, len - 21 }
+    };
+    
+    ck_assert_int_eq(encrypt_trithemius_iov(input, 4, output, 3, 5), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, expected, len);
+    
+    struct iovec in_place[] = {
+        { segmented, 7 }, { segmented + 7, len - 7 }
+    };
+    
+    ck_assert_int_eq(decrypt_trithemius_iov(in_place, 2, in_place, 2, 5), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, text, len);
+    
+    ck_assert_int_eq(encrypt_trithemius_iov(input, 4, output, 2, 5), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(encrypt_trithemius_iov(NULL, 1, output, 3, 5), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+} 
+END_TEST
+
+/**
+ * @brief Test long mixed text against the formula, crossing vector boundaries
+ */
+START_TEST(test_long_text_all_keys)
+{
+    char text[700];
+    
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+        text[i] = (char)(1 + (i * 7) % 255);
+    text[sizeof(text) - 1] = '\0';
+    
+    for (int key = -30; key <= 30; key++)
+    {
+        for (size_t start = 0; start < 70; start += 23)
+        {
+            char* result = NULL;
+            char* back = NULL;
+            size_t pos = 0;
+            
+            ck_assert_int_eq(encrypt_trithemius(text + start, key, &result), CRYPTO_SUCCESS);
+            
+            for (size_t i = 0; text[start + i]; i++)
+            {
+                unsigned char c = (unsigned char)text[start + i];
+                unsigned char expected = c;
+                int k = (int)((((key % 26) + 26) % 26 + pos) % 26);
+                
+                if (c >= 'A' && c <= 'Z')
+                {
+                    expected = (unsigned char)('A' + (c - 'A' + k) % 26);
+                    pos++;
+                }
+                else if (c >= 'a' && c <= 'z')
+                {
+                    expected = (unsigned char)('a' + (c - 'a' + k) % 26);
+                    pos++;
+                }
+                
+                ck_assert_uint_eq((unsigned char)result[i], expected);
+            }
+            
+            ck_assert_int_eq(decrypt_trithemius(result, key, &back), CRYPTO_SUCCESS);
+            ck_assert_str_eq(back, text + start);
+            
+            free(back);
+            free(result);
+        }
+    }
+} 
+END_TEST
+
+/**
+ * @brief Test chunk-parallel variant against serial call
+ */
+START_TEST(test_parallel_matches_serial)
+{
+    size_t len = 1024 * 1024 + 77;
+    char* text = (char*)malloc(len + 1);
+    
+    ck_assert_ptr_nonnull(text);
+    
+    for (size_t i = 0; i < len; i++)
+        text[i] = (char)(1 + (i * i + i / 7) % 255);
+    text[len] = '\0';
+    
+    char* expected = NULL;
+    ck_assert_int_eq(encrypt_trithemius(text, 13, &expected), CRYPTO_SUCCESS);
+    
+    const size_t threads[] = { 1, 3, 16, 0 };
+    
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+    {
+        char* result = NULL;
+        char* back = NULL;
+        
+        ck_assert_int_eq(encrypt_trithemius_parallel(text, 13, threads[t], &result), CRYPTO_SUCCESS);
+        ck_assert_mem_eq(result, expected, len + 1);
+        
+        ck_assert_int_eq(decrypt_trithemius_parallel(result, 13, threads[t], &back), CRYPTO_SUCCESS);
+        ck_assert_mem_eq(back, text, len + 1);
+        
+        free(back);
+        free(result);
+    }
+    
+    ck_assert_int_eq(encrypt_trithemius_parallel(NULL, 13, 2, &expected), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+    free(text);
+} 
+END_TEST
+
+/**
+ * @brief Test streaming in uneven chunks and resuming at letter offset
+ */
+START_TEST(test_stream_matches_oneshot)
+{
+    char text[600];
+    char streamed[sizeof(text)];
+    char* expected = NULL;
+    
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+        text[i] = (char)(1 + (i * 11) % 255);
+    text[sizeof(text) - 1] = '\0';
+    
+    size_t len = strlen(text);
+    ck_assert_int_eq(encrypt_trithemius(text, -9, &expected), CRYPTO_SUCCESS);
+    
+    struct trithemius_stream_ctx ctx;
+    size_t half_letters = 0;
+    ck_assert_int_eq(trithemius_stream_init(&ctx, -9, 0, 0), CRYPTO_SUCCESS);
+    
+    for (size_t offset = 0, chunk = 0; offset < len; offset += chunk)
+    {
+        chunk = (offset % 7) * 13 + 1;
+        if (chunk > len - offset)
+            chunk = len - offset;
+        
+        if (offset <= len / 2)
+            half_letters = ctx.letter_pos;
+        ck_assert_int_eq(trithemius_stream_update(&ctx, text + offset, chunk, streamed + offset), CRYPTO_SUCCESS);
+    }
+    
+    ck_assert_int_eq(trithemius_stream_final(&ctx), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(streamed, expected, len);
+    
+    /* Resume decryption in the middle: letters before it give the offset */
+    size_t middle = 0;
+    for (size_t letters = 0; letters < half_letters; middle++)
+        letters += ((unsigned char)((expected[middle] | 32) - 'a')) < 26;
+    
+    ck_assert_int_eq(trithemius_stream_init(&ctx, -9, 1, half_letters), CRYPTO_SUCCESS);
+    ck_assert_int_eq(trithemius_stream_update(&ctx, expected + middle, len - middle, streamed), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(streamed, text + middle, len - middle);
+    
+    ck_assert_int_eq(trithemius_stream_update(NULL, text, 1, streamed), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+} 
+END_TEST
+
+/**
+ * @brief Test range decryption with index, saved index and no index
+ */
+START_TEST(test_range_with_index)
+{
+    const char* index_path = "test_trithemius_index.tmp";
+    size_t len = 20000;
+    char* text = (char*)malloc(len + 1);
+    char* cipher = NULL;
+    
+    ck_assert_ptr_nonnull(text);
+    
+    for (size_t i = 0; i < len; i++)
+        text[i] = (char)(1 + (i * i + i / 3) % 255);
+    text[len] = '\0';
+    
+    ck_assert_int_eq(encrypt_trithemius(text, 17, &cipher), CRYPTO_SUCCESS);
+    
+    struct letter_index built;
+    struct letter_index loaded;
+    
+    ck_assert_int_eq(letter_index_build(cipher, len, 100, &built), CRYPTO_SUCCESS);
+    ck_assert_int_eq(letter_index_save(&built, index_path), CRYPTO_SUCCESS);
+    ck_assert_int_eq(letter_index_load(index_path, &loaded), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(loaded.count, built.count);
+    ck_assert_mem_eq(loaded.counts, built.counts, built.count * sizeof(uint64_t));
+    remove(index_path);
+    
+    const struct letter_index* indexes[] = { &built, &loaded, NULL };
+    
+    for (size_t n = 0; n < 3; n++)
+    {
+        for (size_t offset = 0; offset < len; offset += 997)
+        {
+            size_t length = len - offset < 300 ? len - offset : 300;
+            char* part = NULL;
+            
+            ck_assert_int_eq(decrypt_trithemius_range(cipher, len, indexes[n], 17, offset, length, &part),
+                CRYPTO_SUCCESS);
+            ck_assert_mem_eq(part, text + offset, length);
+            ck_assert_int_eq(part[length], '\0');
+            
+            free(part);
+        }
+    }
+    
+    char* part = NULL;
+    ck_assert_int_eq(decrypt_trithemius_range(cipher, len, &built, 17, len - 10, 11, &part),
+        CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(decrypt_trithemius_range(cipher, len - 1, &built, 17, 0, 10, &part),
+        CRYPTO_ERROR_INVALID_INPUT);
+    
+    letter_index_free(&loaded);
+    letter_index_free(&built);
+    free(cipher);
+    free(text);
+} 
+END_TEST
+
+/**
+ * @brief Test key recovery from ciphertext only
+ */
+START_TEST(test_crack)
+{
+    const char* text = "It was the best of times, it was the worst of times, "
+        "it was the age of wisdom, it was the age of foolishness.";
+    struct crack_candidate ranked[26];
+    char* cipher = NULL;
+    
+    ck_assert_int_eq(encrypt_trithemius(text, 11, &cipher), CRYPTO_SUCCESS);
+    ck_assert_int_eq(crack_trithemius(cipher, NULL, ranked), CRYPTO_SUCCESS);
+    ck_assert_int_eq(ranked[0].key, 11);
+    
+    const char* lines[] = { cipher, "" };
+    int keys[2];
+    
+    ck_assert_int_eq(crack_trithemius_batch(lines, 2, NULL, 0, keys), CRYPTO_SUCCESS);
+    ck_assert_int_eq(keys[0], 11);
+    ck_assert_int_eq(keys[1], -1);
+    
+    free(cipher);
+} 
+END_TEST
+
 /**
  * @brief Create test suite
  */
@@ -170,8 +473,15 @@ Suite* trithemius_suite(void)
     tcase_add_test(tc_core, test_with_spaces);
     tcase_add_test(tc_core, test_wraparound);
     tcase_add_test(tc_core, test_negative_key);
+    tcase_add_test(tc_core, test_extreme_keys);
     tcase_add_test(tc_core, test_null_input);
     tcase_add_test(tc_core, test_case_preservation);
+    tcase_add_test(tc_core, test_iov_matches_oneshot);
+    tcase_add_test(tc_core, test_long_text_all_keys);
+    tcase_add_test(tc_core, test_parallel_matches_serial);
+    tcase_add_test(tc_core, test_stream_matches_oneshot);
+    tcase_add_test(tc_core, test_range_with_index);
+    tcase_add_test(tc_core, test_crack);
     
     suite_add_tcase(s, tc_core);
     
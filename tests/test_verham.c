@@ -1,6 +1,13 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <check.h>
+#include <pthread.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
 #include "crypto/vernam.h"
 #include "crypto/core.h"
 
@@ -191,6 +198,655 @@ START_TEST(test_zero_key)
 } 
 END_TEST
 
+/**
+ * @brief Test SIMD XOR against byte loop for all tail lengths
+ */
+START_TEST(test_xor_lengths)
+{
+    unsigned char data[600];
+    unsigned char key[600];
+    unsigned char out[600];
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (unsigned char)(i * 7 + 3);
+        key[i] = (unsigned char)(i * 13 + 101);
+    }
+    
+    for (size_t len = 0; len <= 300; len++)
+    {
+        for (size_t shift = 0; shift < 3; shift++)
+        {
+            memset(out, 0xAA, sizeof(out));
+            
+            enum crypto_status status = vernam_xor(data + shift, len, key + 2 * shift, len, out + shift);
+            ck_assert_int_eq(status, CRYPTO_SUCCESS);
+            
+            for (size_t i = 0; i < len; i++)
+                ck_assert_uint_eq(out[shift + i], data[shift + i] ^ key[2 * shift + i]);
+            
+            ck_assert_uint_eq(out[shift + len], 0xAA);
+        }
+    }
+} 
+END_TEST
+
+/**
+ * @brief Test in-place XOR round trip
+ */
+START_TEST(test_xor_in_place)
+{
+    unsigned char data[517];
+    unsigned char original[517];
+    unsigned char key[517];
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = original[i] = (unsigned char)(i ^ 0x5C);
+        key[i] = (unsigned char)(i * 31 + 17);
+    }
+    
+    ck_assert_int_eq(vernam_xor(data, sizeof(data), key, sizeof(key), data), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(data[100], original[100] ^ key[100]);
+    
+    ck_assert_int_eq(vernam_xor(data, sizeof(data), key, sizeof(key), data), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(data, original, sizeof(data));
+    
+    ck_assert_int_eq(vernam_xor(data, 10, key, 9, data), CRYPTO_ERROR_INVALID_KEY);
+    ck_assert_int_eq(vernam_xor(data, 10, key, 10, NULL), CRYPTO_ERROR_NULL_POINTER);
+} 
+END_TEST
+
+/**
+ * @brief Test streaming-store path gives same result as cached path
+ */
+START_TEST(test_xor_stream)
+{
+    static unsigned char data[5000];
+    static unsigned char key[5000];
+    static unsigned char expected[5000];
+    static unsigned char out[5000];
+    size_t saved = vernam_get_stream_threshold();
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (unsigned char)(i * 29 + 1);
+        key[i] = (unsigned char)(i * 3 + 77);
+        expected[i] = data[i] ^ key[i];
+    }
+    
+    vernam_set_stream_threshold(0);
+    ck_assert_uint_eq(vernam_get_stream_threshold(), 0);
+    
+    for (size_t shift = 0; shift < 70; shift += 23)
+    {
+        for (size_t len = 0; len < 4900; len += 97)
+        {
+            memset(out, 0, sizeof(out));
+            ck_assert_int_eq(vernam_xor(data + shift, len, key + shift, len, out + shift), CRYPTO_SUCCESS);
+            ck_assert_mem_eq(out + shift, expected + shift, len);
+        }
+    }
+    
+    memcpy(out, data, sizeof(data));
+    ck_assert_int_eq(vernam_xor(out + 1, 4099, key + 1, 4099, out + 1), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(out + 1, expected + 1, 4099);
+    
+    vernam_set_stream_threshold(saved);
+} 
+END_TEST
+
+/**
+ * @brief Test scatter/gather variant carries key offset across segments
+ */
+START_TEST(test_iov_matches_oneshot)
+{
+    unsigned char data[100];
+    unsigned char key[100];
+    unsigned char segmented[100];
+    unsigned char* expected = NULL;
+    
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (unsigned char)(i * 5);
+        key[i] = (unsigned char)(i * 11 + 3);
+    }
+    
+    ck_assert_int_eq(encrypt_vernam(data, 90, key, sizeof(key), &expected), CRYPTO_SUCCESS);
+    
+    struct iovec input[] = {
+        { data, 33 }, { data + 33, 0 }, { data + 33, 57 }
+    };
+    struct iovec output[] = {
+        { segmented, 1 }, { segmented + 1, 64 }, { segmented + 65, 25 }
+    };
+    
+    ck_assert_int_eq(encrypt_vernam_iov(input, 3, output, 3, key, sizeof(key)), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, expected, 90);
+    
+    ck_assert_int_eq(decrypt_vernam_iov(output, 3, output, 3, key, 90), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, data, 90);
+    
+    ck_assert_int_eq(encrypt_vernam_iov(input, 3, output, 3, key, 89), CRYPTO_ERROR_INVALID_KEY);
+    ck_assert_int_eq(encrypt_vernam_iov(input, 3, output, 2, key, 90), CRYPTO_ERROR_INVALID_INPUT);
+    
+    struct iovec huge[] = {
+        { data, SIZE_MAX / 2 + 1 }, { data, SIZE_MAX / 2 + 1 }
+    };
+    
+    ck_assert_int_eq(encrypt_vernam_iov(huge, 2, huge, 2, key, sizeof(key)), CRYPTO_ERROR_INVALID_INPUT);
+    
+    free(expected);
+} 
+END_TEST
+
+/**
+ * @brief Write bytes to file
+ */
+static void write_file(const char* path, const unsigned char* data, size_t len)
+{
+    FILE* f = fopen(path, "wb");
+    ck_assert_ptr_nonnull(f);
+    ck_assert_uint_eq(fwrite(data, 1, len, f), len);
+    fclose(f);
+}
+
+/**
+ * @brief Read file into buffer, return its length
+ */
+static size_t read_file(const char* path, unsigned char* data, size_t capacity)
+{
+    FILE* f = fopen(path, "rb");
+    ck_assert_ptr_nonnull(f);
+    size_t len = fread(data, 1, capacity, f);
+    fclose(f);
+    return len;
+}
+
+/**
+ * @brief Test file-to-file and in-place file XOR
+ */
+START_TEST(test_xor_file)
+{
+    static unsigned char data[10000];
+    static unsigned char key[10001];
+    static unsigned char out[10002];
+    const char* data_path = "test_vernam_data.tmp";
+    const char* key_path = "test_vernam_key.tmp";
+    const char* out_path = "test_vernam_out.tmp";
+    
+    for (size_t i = 0; i < sizeof(key); i++)
+        key[i] = (unsigned char)(i * 131 + 7);
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i % 251);
+    
+    write_file(data_path, data, sizeof(data));
+    write_file(key_path, key, sizeof(key));
+    write_file(out_path, key, sizeof(key));
+    
+    ck_assert_int_eq(vernam_xor_file(data_path, key_path, out_path), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(read_file(out_path, out, sizeof(out)), sizeof(data));
+    for (size_t i = 0; i < sizeof(data); i++)
+        ck_assert_uint_eq(out[i], data[i] ^ key[i]);
+    
+    ck_assert_int_eq(vernam_xor_file_in_place(out_path, key_path), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(read_file(out_path, out, sizeof(out)), sizeof(data));
+    ck_assert_mem_eq(out, data, sizeof(data));
+    
+    ck_assert_int_eq(vernam_xor_file(key_path, data_path, out_path), CRYPTO_ERROR_INVALID_KEY);
+    ck_assert_int_eq(vernam_xor_file(data_path, key_path, data_path), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(vernam_xor_file(data_path, key_path, key_path), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(vernam_xor_file_in_place(key_path, key_path), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_uint_eq(read_file(key_path, out, sizeof(out)), sizeof(key));
+    ck_assert_mem_eq(out, key, sizeof(key));
+    ck_assert_int_eq(vernam_xor_file("test_vernam_missing.tmp", key_path, out_path), CRYPTO_ERROR_EXECUTION);
+    ck_assert_int_eq(vernam_xor_file_in_place(out_path, NULL), CRYPTO_ERROR_NULL_POINTER);
+    
+    remove(data_path);
+    remove(key_path);
+    remove(out_path);
+} 
+END_TEST
+
+#define PAD_THREADS 8
+#define PAD_MESSAGES 100
+#define PAD_PROCESSES 4
+#define PAD_RESERVATIONS 16
+#define PAD_FIRST_LEASE 256
+
+struct pad_worker {
+    struct vernam_pad* pad;
+    size_t id;
+    uint64_t offsets[PAD_MESSAGES];
+    size_t lengths[PAD_MESSAGES];
+    size_t count;
+};
+
+static void* pad_worker_run(void* arg)
+{
+    struct pad_worker* worker = (struct pad_worker*)arg;
+    unsigned char data[64];
+    
+    for (size_t i = 0; i < PAD_MESSAGES; i++)
+    {
+        size_t len = 1 + (worker->id * 7 + i * 13) % 64;
+        unsigned char* cipher = NULL;
+        unsigned char* plain = NULL;
+        
+        memset(data, (int)(worker->id + i), len);
+        if (vernam_pad_encrypt(worker->pad, data, len, &worker->offsets[worker->count], &cipher) != CRYPTO_SUCCESS)
+            break;
+        
+        if (vernam_pad_decrypt(worker->pad, cipher, len, worker->offsets[worker->count], &plain) == CRYPTO_SUCCESS &&
+            memcmp(plain, data, len) == 0)
+            worker->lengths[worker->count++] = len;
+        
+        free(cipher);
+        free(plain);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Test concurrent pad reservations are disjoint and never overrun the pad
+ */
+START_TEST(test_pad_store)
+{
+    static unsigned char key[20000];
+    static unsigned char used[20000];
+    static struct pad_worker workers[PAD_THREADS];
+    pthread_t threads[PAD_THREADS];
+    const char* pad_path = "test_vernam_pad.tmp";
+    const char* state_path = "test_vernam_pad_state.tmp";
+    struct vernam_pad* pad = NULL;
+    uint64_t remaining;
+    
+    for (size_t i = 0; i < sizeof(key); i++)
+        key[i] = (unsigned char)(i * 17 + 5);
+    
+    remove(state_path);
+    write_file(pad_path, key, sizeof(key));
+    ck_assert_int_eq(vernam_pad_open(pad_path, state_path, &pad), CRYPTO_SUCCESS);
+    
+    for (size_t t = 0; t < PAD_THREADS; t++)
+    {
+        workers[t].pad = pad;
+        workers[t].id = t;
+        workers[t].count = 0;
+        ck_assert_int_eq(pthread_create(&threads[t], NULL, pad_worker_run, &workers[t]), 0);
+    }
+    
+    for (size_t t = 0; t < PAD_THREADS; t++)
+        pthread_join(threads[t], NULL);
+    
+    size_t total = 0;
+    memset(used, 0, sizeof(used));
+    
+    for (size_t t = 0; t < PAD_THREADS; t++)
+    {
+        for (size_t i = 0; i < workers[t].count; i++)
+        {
+            for (size_t j = 0; j < workers[t].lengths[i]; j++)
+            {
+                ck_assert_uint_lt(workers[t].offsets[i] + j, sizeof(used));
+                ck_assert_uint_eq(used[workers[t].offsets[i] + j], 0);
+                used[workers[t].offsets[i] + j] = 1;
+            }
+            total += workers[t].lengths[i];
+        }
+    }
+    
+    ck_assert_int_eq(vernam_pad_remaining(pad, &remaining), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(remaining, sizeof(key) - total);
+    vernam_pad_close(pad);
+    
+    ck_assert_int_eq(vernam_pad_open(pad_path, state_path, &pad), CRYPTO_SUCCESS);
+    ck_assert_int_eq(vernam_pad_remaining(pad, &remaining), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(remaining, sizeof(key) - total);
+    
+    unsigned char big[20000] = {0};
+    unsigned char* result = NULL;
+    uint64_t offset;
+    
+    ck_assert_int_eq(vernam_pad_encrypt(pad, big, (size_t)remaining + 1, &offset, &result), CRYPTO_ERROR_INVALID_KEY);
+    ck_assert_int_eq(vernam_pad_decrypt(pad, big, 1, total, &result), CRYPTO_ERROR_INVALID_KEY);
+    
+    if (remaining > 0)
+    {
+        ck_assert_int_eq(vernam_pad_encrypt(pad, big, (size_t)remaining, &offset, &result), CRYPTO_SUCCESS);
+        ck_assert_uint_eq(offset, total);
+        ck_assert_mem_eq(result, key + total, (size_t)remaining);
+        free(result);
+    }
+    
+    ck_assert_int_eq(vernam_pad_encrypt(pad, big, 1, &offset, &result), CRYPTO_ERROR_INVALID_KEY);
+    vernam_pad_close(pad);
+    
+    write_file(pad_path, key, 100);
+    ck_assert_int_eq(vernam_pad_open(pad_path, state_path, &pad), CRYPTO_ERROR_INVALID_KEY);
+    
+    remove(pad_path);
+    remove(state_path);
+} 
+END_TEST
+
+/**
+ * @brief Test processes sharing one new state file
+ */
+START_TEST(test_pad_processes)
+{
+    static unsigned char key[4096];
+    static unsigned char used[4096];
+    const char* pad_path = "test_vernam_pad_proc.tmp";
+    const char* state_path = "test_vernam_pad_proc_state.tmp";
+    struct vernam_pad* pad = NULL;
+    pid_t children[PAD_PROCESSES];
+    uint64_t remaining;
+    int pipe_fds[2];
+    
+    for (size_t i = 0; i < sizeof(key); i++)
+        key[i] = (unsigned char)(i * 7 + 1);
+    
+    remove(state_path);
+    write_file(pad_path, key, sizeof(key));
+    ck_assert_int_eq(pipe(pipe_fds), 0);
+    
+    for (int p = 0; p < PAD_PROCESSES; p++)
+    {
+        children[p] = fork();
+        ck_assert_int_ge(children[p], 0);
+        
+        if (children[p] == 0)
+        {
+            unsigned char data[8] = {0};
+            int failed = vernam_pad_open(pad_path, state_path, &pad) != CRYPTO_SUCCESS;
+            
+            for (int i = 0; i < PAD_RESERVATIONS && !failed; i++)
+            {
+                unsigned char* result = NULL;
+                uint64_t offset;
+                
+                failed = vernam_pad_encrypt(pad, data, sizeof(data), &offset, &result) != CRYPTO_SUCCESS ||
+                    write(pipe_fds[1], &offset, sizeof(offset)) != (ssize_t)sizeof(offset);
+                free(result);
+            }
+            
+            vernam_pad_close(pad);
+            _exit(failed);
+        }
+    }
+    
+    close(pipe_fds[1]);
+    
+    for (int p = 0; p < PAD_PROCESSES; p++)
+    {
+        int status;
+        ck_assert_int_eq(waitpid(children[p], &status, 0), children[p]);
+        ck_assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    
+    uint64_t offset;
+    size_t count = 0;
+    
+    while (read(pipe_fds[0], &offset, sizeof(offset)) == (ssize_t)sizeof(offset))
+    {
+        ck_assert_uint_le(offset + 8, sizeof(used));
+        
+        for (size_t j = 0; j < 8; j++)
+        {
+            ck_assert_uint_eq(used[offset + j], 0);
+            used[offset + j] = 1;
+        }
+        count++;
+    }
+    
+    close(pipe_fds[0]);
+    ck_assert_uint_eq(count, PAD_PROCESSES * PAD_RESERVATIONS);
+    
+    /* Each child used half of its first lease; only the last lease can be given back */
+    ck_assert_int_eq(vernam_pad_open(pad_path, state_path, &pad), CRYPTO_SUCCESS);
+    ck_assert_int_eq(vernam_pad_remaining(pad, &remaining), CRYPTO_SUCCESS);
+    ck_assert_uint_le(remaining, sizeof(key) - count * 8);
+    ck_assert_uint_ge(remaining, sizeof(key) - PAD_PROCESSES * PAD_FIRST_LEASE);
+    vernam_pad_close(pad);
+    
+    remove(pad_path);
+    remove(state_path);
+} 
+END_TEST
+
+/**
+ * @brief Test lease of a crashed process is skipped, not handed out again
+ */
+START_TEST(test_pad_crash)
+{
+    static unsigned char key[4096];
+    const char* pad_path = "test_vernam_pad_crash.tmp";
+    const char* state_path = "test_vernam_pad_crash_state.tmp";
+    unsigned char data[8] = {0};
+    struct vernam_pad* pad = NULL;
+    unsigned char* result = NULL;
+    uint64_t remaining;
+    uint64_t offset;
+    
+    remove(state_path);
+    write_file(pad_path, key, sizeof(key));
+    
+    pid_t child = fork();
+    ck_assert_int_ge(child, 0);
+    
+    if (child == 0)
+    {
+        int failed = vernam_pad_open(pad_path, state_path, &pad) != CRYPTO_SUCCESS ||
+            vernam_pad_encrypt(pad, data, sizeof(data), &offset, &result) != CRYPTO_SUCCESS;
+        _exit(failed);
+    }
+    
+    int status;
+    ck_assert_int_eq(waitpid(child, &status, 0), child);
+    ck_assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    
+    ck_assert_int_eq(vernam_pad_open(pad_path, state_path, &pad), CRYPTO_SUCCESS);
+    ck_assert_int_eq(vernam_pad_remaining(pad, &remaining), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(remaining, sizeof(key) - PAD_FIRST_LEASE);
+    
+    ck_assert_int_eq(vernam_pad_encrypt(pad, data, sizeof(data), &offset, &result), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(offset, PAD_FIRST_LEASE);
+    free(result);
+    vernam_pad_close(pad);
+    
+    /* Clean close gives back the rest of the lease */
+    ck_assert_int_eq(vernam_pad_open(pad_path, state_path, &pad), CRYPTO_SUCCESS);
+    ck_assert_int_eq(vernam_pad_remaining(pad, &remaining), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(remaining, sizeof(key) - PAD_FIRST_LEASE - sizeof(data));
+    vernam_pad_close(pad);
+    
+    remove(pad_path);
+    remove(state_path);
+} 
+END_TEST
+
+/**
+ * @brief Test key generation into buffer and file
+ */
+START_TEST(test_generate_key)
+{
+    static unsigned char key[4096];
+    static unsigned char file_key[10 * 1024 * 1024 + 123];
+    const char* path = "test_vernam_genkey.tmp";
+    size_t counts[256] = {0};
+    
+    ck_assert_int_eq(vernam_generate_key(key, sizeof(key)), CRYPTO_SUCCESS);
+    for (size_t i = 0; i < sizeof(key); i++)
+        counts[key[i]]++;
+    
+    for (size_t b = 0; b < 256; b++)
+        ck_assert_uint_lt(counts[b], 64);
+    
+    ck_assert_int_eq(vernam_generate_key(NULL, 1), CRYPTO_ERROR_NULL_POINTER);
+    ck_assert_int_eq(vernam_generate_key(key, 0), CRYPTO_ERROR_INVALID_INPUT);
+    
+    remove(path);
+    ck_assert_int_eq(vernam_generate_key_file(path, sizeof(file_key), 3), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(read_file(path, file_key, sizeof(file_key)), sizeof(file_key));
+    
+    for (size_t block = 0; block + 4096 <= sizeof(file_key); block += 4096)
+    {
+        size_t zeros = 0;
+        for (size_t i = 0; i < 4096; i++)
+            zeros += file_key[block + i] == 0;
+        ck_assert_uint_lt(zeros, 64);
+    }
+    
+    ck_assert_int_eq(vernam_generate_key_file(path, 10, 0), CRYPTO_ERROR_EXECUTION);
+    ck_assert_uint_eq(read_file(path, file_key, sizeof(file_key)), sizeof(file_key));
+    
+    remove(path);
+    ck_assert_int_eq(vernam_generate_key_file(path, 10, 0), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(read_file(path, file_key, sizeof(file_key)), 10);
+    ck_assert_int_eq(vernam_generate_key_file(path, 0, 0), CRYPTO_ERROR_INVALID_INPUT);
+    
+    remove(path);
+} 
+END_TEST
+
+/**
+ * @brief Test two-time-pad detection and crib dragging
+ */
+START_TEST(test_key_reuse)
+{
+    static const char* texts[] = {
+        "the army will cross the river at first light and hold the bridge",
+        "please send more supplies to the eastern camp before the winter",
+        "our agent in the capital reports that the meeting was cancelled"
+    };
+    static unsigned char storage[300][80];
+    static unsigned char key[80];
+    const unsigned char* ciphertexts[300];
+    size_t lengths[300];
+    struct vernam_reuse_pair pairs[8];
+    struct vernam_crib_hit hits[8];
+    uint64_t found = 0;
+    uint32_t x = 2463534242U;
+    
+    for (size_t i = 0; i < 300; i++)
+    {
+        for (size_t j = 0; j < 80; j++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            storage[i][j] = (unsigned char)(x >> 3);
+        }
+        ciphertexts[i] = storage[i];
+        lengths[i] = 40 + i % 40;
+    }
+    
+    memcpy(key, storage[0], sizeof(key));
+    for (size_t t = 0; t < 3; t++)
+    {
+        size_t index = 50 + t * 100;
+        lengths[index] = strlen(texts[t]);
+        ck_assert_int_eq(vernam_xor((const unsigned char*)texts[t], lengths[index], key, sizeof(key), storage[index]), CRYPTO_SUCCESS);
+    }
+    lengths[0] = 10;
+    
+    ck_assert_int_eq(vernam_find_key_reuse(ciphertexts, lengths, 300, pairs, 8, &found), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(found, 3);
+    ck_assert_uint_eq(pairs[0].first < pairs[0].second, 1);
+    
+    for (size_t p = 0; p < 3; p++)
+    {
+        ck_assert_uint_eq(pairs[p].first % 100, 50);
+        ck_assert_uint_eq(pairs[p].second % 100, 50);
+    }
+    
+    const char* crib = " the river";
+    struct vernam_reuse_pair pair = {50, 150, 0};
+    
+    ck_assert_int_eq(vernam_crib_drag(ciphertexts, lengths, &pair, 1, (const unsigned char*)crib, strlen(crib), 2, hits), CRYPTO_SUCCESS);
+    ck_assert_int_eq(hits[0].found, 1);
+    ck_assert_uint_eq(hits[0].position, strstr(texts[0], crib) - texts[0]);
+    
+    ck_assert_int_eq(vernam_crib_drag(ciphertexts, lengths, pairs, 3, (const unsigned char*)" the ", 5, 0, hits), CRYPTO_SUCCESS);
+    for (size_t p = 0; p < 3; p++)
+        ck_assert_int_eq(hits[p].found, 1);
+    
+    ck_assert_int_eq(vernam_find_key_reuse(ciphertexts, lengths, 300, NULL, 0, &found), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(found, 3);
+    
+    storage[150][2] ^= 0x80;
+    ck_assert_int_eq(vernam_find_key_reuse(ciphertexts, lengths, 300, pairs, 8, &found), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(found, 3);
+    
+    storage[250][7] ^= 0x80;
+    ck_assert_int_eq(vernam_find_key_reuse(ciphertexts, lengths, 300, pairs, 8, &found), CRYPTO_SUCCESS);
+    ck_assert_uint_eq(found, 3);
+    ck_assert_int_eq(vernam_crib_drag(ciphertexts, lengths, pairs, 3, NULL, 5, 0, hits), CRYPTO_ERROR_NULL_POINTER);
+} 
+END_TEST
+
+#define REUSE_SCALE_SMALL (1 << 15)
+#define REUSE_SCALE_LARGE (1 << 17)
+
+/**
+ * @brief Best of three times of vernam_find_key_reuse on count random ciphertexts
+ */
+static double key_reuse_seconds(const unsigned char* const* ciphertexts, const size_t* lengths, size_t count)
+{
+    double best = 0;
+    
+    for (int run = 0; run < 3; run++)
+    {
+        struct timespec start, end;
+        uint64_t found;
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ck_assert_int_eq(vernam_find_key_reuse(ciphertexts, lengths, count, NULL, 0, &found), CRYPTO_SUCCESS);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        
+        double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        if (run == 0 || seconds < best)
+            best = seconds;
+    }
+    
+    return best;
+}
+
+/**
+ * @brief Test key reuse search cost grows close to linearly, not with all pairs
+ * 
+ * Four times the ciphertexts would take sixteen times as long if all
+ * pairs, or a fixed fraction of them, were compared.
+ */
+START_TEST(test_key_reuse_scaling)
+{
+    static unsigned char storage[REUSE_SCALE_LARGE][32];
+    static const unsigned char* ciphertexts[REUSE_SCALE_LARGE];
+    static size_t lengths[REUSE_SCALE_LARGE];
+    uint32_t x = 2463534242U;
+    
+    for (size_t i = 0; i < REUSE_SCALE_LARGE; i++)
+    {
+        for (size_t j = 0; j < 32; j++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            storage[i][j] = (unsigned char)(x >> 3);
+        }
+        ciphertexts[i] = storage[i];
+        lengths[i] = 32;
+    }
+    
+    double small = key_reuse_seconds(ciphertexts, lengths, REUSE_SCALE_SMALL);
+    double large = key_reuse_seconds(ciphertexts, lengths, REUSE_SCALE_LARGE);
+    
+    ck_assert(large < small * 8);
+} 
+END_TEST
+
 /**
  * @brief Create test suite
  */
@@ -210,6 +866,17 @@ Suite* vernam_suite(void)
     tcase_add_test(tc_core, test_key_longer);
     tcase_add_test(tc_core, test_null_input);
     tcase_add_test(tc_core, test_zero_key);
+    tcase_add_test(tc_core, test_xor_lengths);
+    tcase_add_test(tc_core, test_xor_in_place);
+    tcase_add_test(tc_core, test_xor_stream);
+    tcase_add_test(tc_core, test_iov_matches_oneshot);
+    tcase_add_test(tc_core, test_xor_file);
+    tcase_add_test(tc_core, test_generate_key);
+    tcase_add_test(tc_core, test_pad_store);
+    tcase_add_test(tc_core, test_pad_processes);
+    tcase_add_test(tc_core, test_pad_crash);
+    tcase_add_test(tc_core, test_key_reuse);
+    tcase_add_test(tc_core, test_key_reuse_scaling);
     
     suite_add_tcase(s, tc_core);
     
@@ -1,5 +1,6 @@
 #include <check.h>
 #include <stdlib.h>
+#include <string.h>
 #include "crypto/vigenere.h"
 #include "crypto/core.h"
 
@@ -162,6 +163,171 @@ START_TEST(test_single_letter_key)
 } 
 END_TEST
 
+/**
+ * @brief Test scatter/gather variant against one-shot call
+ */
+START_TEST(test_iov_matches_oneshot)
+{
+    char text[] = "Attack at dawn, hold the line! Zebra xylophone.";
+    char segmented[sizeof(text)];
+    char* expected = NULL;
+    size_t len = strlen(text);
+    
+    ck_assert_int_eq(encrypt_vigenere(text, "LeMoN", &expected), CRYPTO_SUCCESS);
+    
+    struct iovec input[] = {
+        { text, 5 }, { text + 5, 0 }, { text + 5, 13 }, { text + 18, len - 18 }
+    };
+    struct iovec output[] = {
+        { segmented, 1 }, { segmented + 1, 20 }, { segmented + 21, len - 21 }
+    };
+    
+    ck_assert_int_eq(encrypt_vigenere_iov(input, 4, output, 3, "LeMoN"), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, expected, len);
+    
+    struct iovec in_place[] = {
+        { segmented, 7 }, { segmented + 7, len - 7 }
+    };
+    
+    ck_assert_int_eq(decrypt_vigenere_iov(in_place, 2, in_place, 2, "LeMoN"), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(segmented, text, len);
+    
+    ck_assert_int_eq(encrypt_vigenere_iov(input, 4, output, 2, "LeMoN"), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(encrypt_vigenere_iov(NULL, 1, output, 3, "LeMoN"), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+} 
+END_TEST
+
+/**
+ * @brief Test streaming in uneven chunks and resuming at letter offset
+ */
+START_TEST(test_stream_matches_oneshot)
+{
+    char text[600];
+    char streamed[sizeof(text)];
+    char* expected = NULL;
+    
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+        text[i] = (char)(1 + (i * 11) % 255);
+    text[sizeof(text) - 1] = '\0';
+    
+    size_t len = strlen(text);
+    ck_assert_int_eq(encrypt_vigenere(text, "Lemon", &expected), CRYPTO_SUCCESS);
+    
+    struct vigenere_stream_ctx ctx;
+    size_t half_letters = 0;
+    ck_assert_int_eq(vigenere_stream_init(&ctx, "Lemon", 0, 0), CRYPTO_SUCCESS);
+    
+    for (size_t offset = 0, chunk = 0; offset < len; offset += chunk)
+    {
+        chunk = (offset % 7) * 13 + 1;
+        if (chunk > len - offset)
+            chunk = len - offset;
+        
+        if (offset <= len / 2)
+            half_letters = ctx.key_pos;
+        ck_assert_int_eq(vigenere_stream_update(&ctx, text + offset, chunk, streamed + offset), CRYPTO_SUCCESS);
+    }
+    
+    ck_assert_int_eq(vigenere_stream_final(&ctx), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(streamed, expected, len);
+    
+    /* Resume decryption in the middle: letters before it give the offset */
+    size_t middle = 0;
+    for (size_t letters = 0; letters < half_letters; middle++)
+        letters += ((unsigned char)((expected[middle] | 32) - 'a')) < 26;
+    
+    ck_assert_int_eq(vigenere_stream_init(&ctx, "Lemon", 1, half_letters), CRYPTO_SUCCESS);
+    ck_assert_int_eq(vigenere_stream_update(&ctx, expected + middle, len - middle, streamed), CRYPTO_SUCCESS);
+    ck_assert_mem_eq(streamed, text + middle, len - middle);
+    
+    ck_assert_int_eq(vigenere_stream_update(NULL, text, 1, streamed), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+} 
+END_TEST
+
+/**
+ * @brief Test range decryption at every offset of a short text
+ */
+START_TEST(test_range_with_index)
+{
+    const char* text = "Meet me at the old mill, 12:30 sharp. Bring the map and two lanterns!";
+    size_t len = strlen(text);
+    char* cipher = NULL;
+    struct letter_index index;
+    
+    ck_assert_int_eq(encrypt_vigenere(text, "Lemon", &cipher), CRYPTO_SUCCESS);
+    ck_assert_int_eq(letter_index_build(text, len, 8, &index), CRYPTO_SUCCESS);
+    
+    for (size_t offset = 0; offset < len; offset++)
+    {
+        char* with_index = NULL;
+        char* without_index = NULL;
+        
+        ck_assert_int_eq(decrypt_vigenere_range(cipher, len, &index, "Lemon", offset, len - offset, &with_index),
+            CRYPTO_SUCCESS);
+        ck_assert_str_eq(with_index, text + offset);
+        
+        ck_assert_int_eq(decrypt_vigenere_range(cipher, len, NULL, "Lemon", offset, 1, &without_index),
+            CRYPTO_SUCCESS);
+        ck_assert_int_eq(without_index[0], text[offset]);
+        
+        free(without_index);
+        free(with_index);
+    }
+    
+    char* part = NULL;
+    ck_assert_int_eq(decrypt_vigenere_range(cipher, len, &index, "Lemon", 0, 0, &part), CRYPTO_ERROR_INVALID_INPUT);
+    ck_assert_int_eq(decrypt_vigenere_range(cipher, len, &index, "L3mon", 0, 1, &part), CRYPTO_ERROR_INVALID_KEY);
+    
+    letter_index_free(&index);
+    free(cipher);
+} 
+END_TEST
+
+/**
+ * @brief Test chunk-parallel variant against serial call
+ */
+START_TEST(test_parallel_matches_serial)
+{
+    size_t len = 1024 * 1024 + 77;
+    char* text = (char*)malloc(len + 1);
+    
+    ck_assert_ptr_nonnull(text);
+    
+    for (size_t i = 0; i < len; i++)
+        text[i] = (char)(1 + (i * i + i / 7) % 255);
+    text[len] = '\0';
+    
+    char* expected = NULL;
+    ck_assert_int_eq(encrypt_vigenere(text, "Lemon", &expected), CRYPTO_SUCCESS);
+    
+    const size_t threads[] = { 1, 3, 16, 0 };
+    
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+    {
+        char* result = NULL;
+        char* back = NULL;
+        
+        ck_assert_int_eq(encrypt_vigenere_parallel(text, "Lemon", threads[t], &result), CRYPTO_SUCCESS);
+        ck_assert_mem_eq(result, expected, len + 1);
+        
+        ck_assert_int_eq(decrypt_vigenere_parallel(result, "Lemon", threads[t], &back), CRYPTO_SUCCESS);
+        ck_assert_mem_eq(back, text, len + 1);
+        
+        free(back);
+        free(result);
+    }
+    
+    ck_assert_int_eq(encrypt_vigenere_parallel(NULL, "Lemon", 2, &expected), CRYPTO_ERROR_NULL_POINTER);
+    
+    free(expected);
+    free(text);
+} 
+END_TEST
+
 /**
  * @brief Create test suite
  */
@@ -182,6 +348,10 @@ Suite* vigenere_suite(void)
     tcase_add_test(tc_core, test_empty_key);
     tcase_add_test(tc_core, test_null_input);
     tcase_add_test(tc_core, test_single_letter_key);
+    tcase_add_test(tc_core, test_iov_matches_oneshot);
+    tcase_add_test(tc_core, test_stream_matches_oneshot);
+    tcase_add_test(tc_core, test_range_with_index);
+    tcase_add_test(tc_core, test_parallel_matches_serial);
     
     suite_add_tcase(s, tc_core);
     